@@ -0,0 +1,133 @@
+/**
+ * @file main.c
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief this example measure time of CmdManager_processLine per line
+ * with Str functions and with single pass character class tokenizer
+ * Example Configuration
+ * - #define CMD_CHAR_CLASS                      1
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+    #define BENCHMARK_CYCLES    1
+#else
+    #define BENCHMARK_CYCLES    0
+#endif
+
+#include "Str.h"
+#include "CmdManager.h"
+
+#define BENCHMARK_ROUNDS        200000
+
+Cmd_Handled Benchmark_onCmd(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type);
+const Cmd CMD_ADC = CMD_INIT("adc", Cmd_Type_Any, Benchmark_onCmd, Benchmark_onCmd, Benchmark_onCmd, Benchmark_onCmd, Benchmark_onCmd);
+const Cmd CMD_BAUD = CMD_INIT("baud", Cmd_Type_Any, Benchmark_onCmd, Benchmark_onCmd, Benchmark_onCmd, Benchmark_onCmd, Benchmark_onCmd);
+const Cmd CMD_GPIO = CMD_INIT("gpio", Cmd_Type_Any, Benchmark_onCmd, Benchmark_onCmd, Benchmark_onCmd, Benchmark_onCmd, Benchmark_onCmd);
+const Cmd CMD_LED = CMD_INIT("led", Cmd_Type_Any, Benchmark_onCmd, Benchmark_onCmd, Benchmark_onCmd, Benchmark_onCmd, Benchmark_onCmd);
+const Cmd CMD_PWM = CMD_INIT("pwm", Cmd_Type_Any, Benchmark_onCmd, Benchmark_onCmd, Benchmark_onCmd, Benchmark_onCmd, Benchmark_onCmd);
+const Cmd CMD_RESET = CMD_INIT("reset", Cmd_Type_Any, Benchmark_onCmd, Benchmark_onCmd, Benchmark_onCmd, Benchmark_onCmd, Benchmark_onCmd);
+const Cmd CMD_STATUS = CMD_INIT("status", Cmd_Type_Any, Benchmark_onCmd, Benchmark_onCmd, Benchmark_onCmd, Benchmark_onCmd, Benchmark_onCmd);
+const Cmd CMD_TEMPERATURE = CMD_INIT("temperature", Cmd_Type_Any, Benchmark_onCmd, Benchmark_onCmd, Benchmark_onCmd, Benchmark_onCmd, Benchmark_onCmd);
+
+const Cmd_Array CMDS[] = {
+    &CMD_ADC,
+    &CMD_BAUD,
+    &CMD_GPIO,
+    &CMD_LED,
+    &CMD_PWM,
+    &CMD_RESET,
+    &CMD_STATUS,
+    &CMD_TEMPERATURE,
+};
+const Mem_LenType CMDS_LEN = CMD_ARR_LEN(CMDS);
+
+static const char* const LINES[] = {
+    "led=1",
+    "  PWM = 1,50,0",
+    "status?",
+    "Temperature?",
+    "gpio=12,1",
+    "baud = 115200",
+    "adc",
+    "unknown=1",
+};
+#define LINES_LEN               (sizeof(LINES) / sizeof(LINES[0]))
+
+static uint32_t calls;
+
+static void Benchmark_run(CmdManager* manager, const char* name);
+static uint64_t Benchmark_now(void);
+
+int main(void) {
+    CmdManager manager;
+    static Cmd_CharClass charClass;
+
+    CmdManager_init(&manager, (Cmd_Array*) CMDS, CMDS_LEN);
+
+    CmdManager_setCharClass(&manager, NULL);
+    Benchmark_run(&manager, "str functions");
+
+    CmdCharClass_init(&charClass);
+    CmdManager_setCharClass(&manager, &charClass);
+    Benchmark_run(&manager, "char class");
+
+    return calls == 0;
+}
+
+Cmd_Handled Benchmark_onCmd(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    calls++;
+    return Cmd_Done;
+}
+
+static void Benchmark_run(CmdManager* manager, const char* name) {
+    char buffer[LINES_LEN][32];
+    Str_LenType lens[LINES_LEN];
+    Param_Cursor cursor;
+    uint64_t start;
+    uint64_t end;
+#if BENCHMARK_CYCLES
+    uint64_t cycles;
+#endif
+    uint32_t round;
+    uint32_t index;
+
+    for (index = 0; index < LINES_LEN; index++) {
+        lens[index] = (Str_LenType) strlen(LINES[index]);
+    }
+    start = Benchmark_now();
+#if BENCHMARK_CYCLES
+    cycles = __rdtsc();
+#endif
+    for (round = 0; round < BENCHMARK_ROUNDS; round++) {
+        for (index = 0; index < LINES_LEN; index++) {
+            // lines modify while process
+            memcpy(buffer[index], LINES[index], lens[index] + 1);
+            CmdManager_processLine(manager, buffer[index], lens[index], &cursor);
+        }
+    }
+#if BENCHMARK_CYCLES
+    cycles = __rdtsc() - cycles;
+#endif
+    end = Benchmark_now();
+    printf("%-16s %6.1f ns/line", name, (double) (end - start) / (BENCHMARK_ROUNDS * LINES_LEN));
+#if BENCHMARK_CYCLES
+    printf(", %6.1f cycles/line", (double) cycles / (BENCHMARK_ROUNDS * LINES_LEN));
+#endif
+    printf("\n");
+}
+
+static uint64_t Benchmark_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
@@ -0,0 +1,223 @@
+/**
+ * @file main.c
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief this example compare round trip time of commands between two processes
+ * over CmdIpc shared memory and over loopback TCP socket
+ * server process run CmdIpc_poll in main thread and TCP server in another thread,
+ * client process send "ping?" and wait for response of each command
+ * Example Configuration
+ * - #define CMD_IPC                             1
+ * - #define CMD_MANAGER_ARGS                    1
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#include "Str.h"
+#include "CmdManager.h"
+#include "CmdIpc.h"
+
+#define IPC_NAME                "/cmd-ipc-example"
+#define IPC_ROUNDS              100000
+#define IPC_PORT                45123
+#define IPC_RESPONSE            "+PING: 1\r\n"
+
+Cmd_Handled Ipc_onPing(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type);
+const Cmd CMD_PING = CMD_INIT("ping", Cmd_Type_Any, Ipc_onPing, Ipc_onPing, Ipc_onPing, Ipc_onPing, Ipc_onPing);
+
+const Cmd_Array CMDS[] = {
+    &CMD_PING,
+};
+const Mem_LenType CMDS_LEN = CMD_ARR_LEN(CMDS);
+
+static void Ipc_server(CmdIpc_Server* server, int listener);
+static void* Ipc_serveTcp(void* args);
+static void Ipc_clientIpc(void);
+static void Ipc_clientTcp(void);
+static uint64_t Ipc_now(void);
+
+int main(void) {
+    static CmdIpc_Server server;
+    CmdManager manager;
+    struct sockaddr_in addr;
+    int listener;
+    int option = 1;
+    pid_t pid;
+
+    CmdManager_init(&manager, (Cmd_Array*) CMDS, CMDS_LEN);
+    CmdManager_setArgs(&manager, NULL);
+    // open both servers before fork, so client don't wait for them
+    if (CmdIpc_open(&server, IPC_NAME, &manager) != CmdIpc_Ok) {
+        printf("can not open shared memory\n");
+        return 1;
+    }
+    listener = socket(AF_INET, SOCK_STREAM, 0);
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &option, sizeof(option));
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(IPC_PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(listener, (struct sockaddr*) &addr, sizeof(addr)) != 0 || listen(listener, 1) != 0) {
+        printf("can not listen on port %d\n", IPC_PORT);
+        CmdIpc_close(&server);
+        return 1;
+    }
+
+    pid = fork();
+    if (pid == 0) {
+        Ipc_server(&server, listener);
+        return 0;
+    }
+    close(listener);
+    Ipc_clientIpc();
+    Ipc_clientTcp();
+
+    kill(pid, SIGTERM);
+    waitpid(pid, NULL, 0);
+    CmdIpc_close(&server);
+    return 0;
+}
+
+Cmd_Handled Ipc_onPing(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    int* fd = (int*) CmdManager_getArgs(manager);
+
+    if (fd != NULL) {
+        // TCP session
+        if (write(*fd, IPC_RESPONSE, sizeof(IPC_RESPONSE) - 1) < 0) {
+            return Cmd_Error;
+        }
+    }
+    else {
+        CmdIpc_respond(manager, IPC_RESPONSE, sizeof(IPC_RESPONSE) - 1);
+    }
+    return Cmd_Done;
+}
+
+static void Ipc_server(CmdIpc_Server* server, int listener) {
+    pthread_t thread;
+    static int fd;
+
+    fd = listener;
+    pthread_create(&thread, NULL, Ipc_serveTcp, &fd);
+    for (;;) {
+        CmdIpc_poll(server, -1);
+    }
+}
+static void* Ipc_serveTcp(void* args) {
+    CmdManager manager;
+    Param_Cursor cursor;
+    char buffer[1024];
+    Str_LenType len = 0;
+    ssize_t n;
+    char* end;
+    char* line;
+    int fd;
+    int option = 1;
+
+    fd = accept(*(int*) args, NULL, NULL);
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &option, sizeof(option));
+    CmdManager_init(&manager, (Cmd_Array*) CMDS, CMDS_LEN);
+    CmdManager_setArgs(&manager, &fd);
+    for (;;) {
+        n = read(fd, &buffer[len], sizeof(buffer) - 1 - (size_t) len);
+        if (n <= 0) {
+            break;
+        }
+        len += (Str_LenType) n;
+        buffer[len] = '\0';
+        line = buffer;
+        while ((end = strstr(line, "\r\n")) != NULL) {
+            *end = '\0';
+            CmdManager_processLine(&manager, line, (Str_LenType) (end - line), &cursor);
+            line = end + 2;
+        }
+        len -= (Str_LenType) (line - buffer);
+        memmove(buffer, line, (size_t) len);
+    }
+    close(fd);
+    return NULL;
+}
+static void Ipc_clientIpc(void) {
+    CmdIpc_Client client;
+    char response[64];
+    uint32_t received;
+    uint64_t start;
+    uint32_t round;
+
+    if (CmdIpcClient_connect(&client, IPC_NAME) != CmdIpc_Ok) {
+        printf("can not connect to ipc server\n");
+        return;
+    }
+    start = Ipc_now();
+    for (round = 0; round < IPC_ROUNDS; round++) {
+        CmdIpcClient_send(&client, "ping?", 5, -1);
+        received = 0;
+        while (received < sizeof(IPC_RESPONSE) - 1) {
+            received += CmdIpcClient_receive(&client, &response[received], sizeof(response) - received, -1);
+        }
+    }
+    start = Ipc_now() - start;
+    printf("ipc  %8.2f us/round trip\n", (double) start / IPC_ROUNDS / 1000.0);
+    CmdIpcClient_close(&client);
+}
+static void Ipc_clientTcp(void) {
+    struct sockaddr_in addr;
+    char response[64];
+    size_t received;
+    ssize_t n;
+    uint64_t start;
+    uint32_t round;
+    int option = 1;
+    int fd;
+
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(IPC_PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, (struct sockaddr*) &addr, sizeof(addr)) != 0) {
+        printf("can not connect to tcp server\n");
+        close(fd);
+        return;
+    }
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &option, sizeof(option));
+    start = Ipc_now();
+    for (round = 0; round < IPC_ROUNDS; round++) {
+        if (write(fd, "ping?\r\n", 7) != 7) {
+            break;
+        }
+        received = 0;
+        while (received < sizeof(IPC_RESPONSE) - 1) {
+            n = read(fd, &response[received], sizeof(response) - received);
+            if (n <= 0) {
+                break;
+            }
+            received += (size_t) n;
+        }
+    }
+    start = Ipc_now() - start;
+    printf("tcp  %8.2f us/round trip\n", (double) start / IPC_ROUNDS / 1000.0);
+    close(fd);
+}
+
+static uint64_t Ipc_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
@@ -0,0 +1,121 @@
+/**
+ * @file main.c
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief this example push lines from multiple producer threads into one CmdQueue
+ * and drain them into CmdManager from main thread, check order of each producer
+ * and report lines/s
+ * Example Configuration
+ * - #define CMD_QUEUE                           1
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+
+#include "Str.h"
+#include "CmdManager.h"
+#include "CmdQueue.h"
+
+#define QUEUE_PRODUCERS         4
+#define QUEUE_LINES             200000
+#define QUEUE_SIZE              256
+#define QUEUE_LINE_SIZE         32
+
+Cmd_Handled Queue_onSet(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type);
+const Cmd CMD_SEQ = CMD_INIT("seq", Cmd_Type_Set, NULL, Queue_onSet, NULL, NULL, NULL);
+
+const Cmd_Array CMDS[] = {
+    &CMD_SEQ,
+};
+const Mem_LenType CMDS_LEN = CMD_ARR_LEN(CMDS);
+
+static CmdQueue queue;
+static CmdQueue_Slot slots[QUEUE_SIZE];
+static char lines[QUEUE_SIZE][QUEUE_LINE_SIZE];
+static int32_t last[QUEUE_PRODUCERS];
+static uint32_t received;
+static uint32_t outOfOrder;
+static uint32_t retries;
+
+static void* Queue_produce(void* args);
+static uint64_t Queue_now(void);
+
+int main(void) {
+    CmdManager manager;
+    Param_Cursor cursor;
+    pthread_t threads[QUEUE_PRODUCERS];
+    uint8_t ids[QUEUE_PRODUCERS];
+    uint64_t start;
+    uint8_t index;
+
+    CmdManager_init(&manager, (Cmd_Array*) CMDS, CMDS_LEN);
+    CmdQueue_init(&queue, slots, (char*) lines, QUEUE_SIZE, QUEUE_LINE_SIZE);
+
+    start = Queue_now();
+    for (index = 0; index < QUEUE_PRODUCERS; index++) {
+        last[index] = -1;
+        ids[index] = index;
+        pthread_create(&threads[index], NULL, Queue_produce, &ids[index]);
+    }
+    while (received < QUEUE_PRODUCERS * QUEUE_LINES) {
+        if (CmdQueue_drain(&queue, &manager, 64, &cursor) == 0) {
+            sched_yield();
+        }
+    }
+    start = Queue_now() - start;
+    for (index = 0; index < QUEUE_PRODUCERS; index++) {
+        pthread_join(threads[index], NULL);
+    }
+
+    printf("received %u lines, %.0f lines/s\n", received, (double) received * 1e9 / (double) start);
+    printf("out of order %u, full retries %u, dropped %u\n", outOfOrder, retries, CmdQueue_dropped(&queue));
+
+    return outOfOrder != 0;
+}
+
+Cmd_Handled Queue_onSet(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    Param param;
+    int32_t producer;
+
+    Param_next(cursor, &param);
+    producer = param.Value.Number;
+    Param_next(cursor, &param);
+    if (param.Value.Number != last[producer] + 1) {
+        outOfOrder++;
+    }
+    last[producer] = param.Value.Number;
+    received++;
+    return Cmd_Done;
+}
+
+static void* Queue_produce(void* args) {
+    uint8_t id = *(uint8_t*) args;
+    char line[QUEUE_LINE_SIZE];
+    Str_LenType len;
+    uint32_t count;
+
+    for (count = 0; count < QUEUE_LINES; count++) {
+        len = (Str_LenType) snprintf(line, sizeof(line), "seq=%u,%u", id, count);
+        // queue never block, producer choose to retry or drop
+        while (CmdQueue_push(&queue, line, len) == CmdQueue_Full) {
+            __atomic_add_fetch(&retries, 1, __ATOMIC_RELAXED);
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static uint64_t Queue_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
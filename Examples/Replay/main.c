@@ -0,0 +1,209 @@
+/**
+ * @file main.c
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief this example replay a capture log into CmdManager and report throughput and latency
+ * capture log can record on device with CmdCapture
+ * Example Configuration
+ * - #define CMD_CAPTURE                         1
+ * - #define CMD_DEFAULT_END_WITH                "\n"
+ * replace CMDS with commands of your application for a realistic benchmark
+ * usage: replay <capture.log> [--pace]
+ * --pace: replay with original timing, default is max speed
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Str.h"
+#include "CmdManager.h"
+#include "CmdCapture.h"
+
+#define LINE_BUFFER_SIZE        1024
+
+Cmd_Handled Replay_onCmd(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type);
+const Cmd CMD_LED = CMD_INIT("led", Cmd_Type_Any, Replay_onCmd, Replay_onCmd, Replay_onCmd, Replay_onCmd, Replay_onCmd);
+const Cmd CMD_PWM = CMD_INIT("pwm", Cmd_Type_Any, Replay_onCmd, Replay_onCmd, Replay_onCmd, Replay_onCmd, Replay_onCmd);
+const Cmd CMD_STATUS = CMD_INIT("status", Cmd_Type_Any, Replay_onCmd, Replay_onCmd, Replay_onCmd, Replay_onCmd, Replay_onCmd);
+
+const Cmd_Array CMDS[] = {
+    &CMD_LED,
+    &CMD_PWM,
+    &CMD_STATUS,
+};
+const Mem_LenType CMDS_LEN = CMD_ARR_LEN(CMDS);
+
+static uint64_t params;
+static uint64_t notFound;
+
+static uint64_t Replay_now(void);
+static void Replay_sleepUntil(uint64_t time);
+static void Replay_onNotFound(CmdManager* manager, char* str);
+static int Replay_compare(const void* a, const void* b);
+static uint8_t* Replay_readFile(const char* path, uint32_t* len);
+
+int main(int argc, char* argv[]) {
+    CmdManager manager;
+    Param_Cursor cursor;
+    CmdCapture_Reader reader;
+    CmdCapture_Record record;
+    CmdCapture_Result result;
+    char line[LINE_BUFFER_SIZE];
+    uint32_t lineLen = 0;
+    uint64_t* latencies;
+    uint64_t lines = 0;
+    uint64_t records = 0;
+    uint64_t start;
+    uint64_t end;
+    uint32_t len;
+    uint8_t* data;
+    uint8_t pace;
+
+    if (argc < 2) {
+        printf("usage: %s <capture.log> [--pace]\n", argv[0]);
+        return 1;
+    }
+    pace = argc > 2 && strcmp(argv[2], "--pace") == 0;
+    data = Replay_readFile(argv[1], &len);
+    if (data == NULL) {
+        printf("can not read %s\n", argv[1]);
+        return 1;
+    }
+    if (CmdCapture_open(&reader, data, len) != CmdCapture_Ok) {
+        printf("invalid capture log\n");
+        free(data);
+        return 1;
+    }
+    // at most one latency sample per record
+    latencies = malloc(sizeof(uint64_t) * (len / 2 + 1));
+    if (latencies == NULL) {
+        printf("can not allocate latencies\n");
+        free(data);
+        return 1;
+    }
+
+    CmdManager_init(&manager, (Cmd_Array*) CMDS, CMDS_LEN);
+    CmdManager_onNotFound(&manager, Replay_onNotFound);
+
+    start = Replay_now();
+    while ((result = CmdCapture_next(&reader, &record)) == CmdCapture_Ok) {
+        const char* ptr = record.Data;
+        uint32_t remain = record.Len;
+        uint64_t begin;
+
+        if (pace) {
+            Replay_sleepUntil(start + record.Time * 1000);
+        }
+        begin = Replay_now();
+        // feed bytes and process each completed line
+        while (remain > 0) {
+            char* endWith;
+            uint32_t copy = remain < sizeof(line) - 1 - lineLen ? remain : sizeof(line) - 1 - lineLen;
+
+            memcpy(&line[lineLen], ptr, copy);
+            lineLen += copy;
+            ptr += copy;
+            remain -= copy;
+            line[lineLen] = '\0';
+            while ((endWith = strstr(line, manager.EndWith->Text)) != NULL) {
+                uint32_t frameLen = (uint32_t) (endWith - line) + manager.EndWith->Len;
+                if (endWith != line) {
+                    CmdManager_process(&manager, line, frameLen, &cursor);
+                    lines++;
+                }
+                lineLen -= frameLen;
+                memmove(line, &line[frameLen], lineLen + 1);
+            }
+            if (lineLen == sizeof(line) - 1) {
+                // drop too long line
+                lineLen = 0;
+            }
+        }
+        latencies[records++] = Replay_now() - begin;
+    }
+    end = Replay_now();
+
+    if (result == CmdCapture_Truncated) {
+        printf("capture log truncated\n");
+    }
+    if (records > 0) {
+        double seconds = (double) (end - start) / 1e9;
+        qsort(latencies, records, sizeof(uint64_t), Replay_compare);
+        printf("records: %llu, lines: %llu, not found: %llu, params: %llu\n",
+               (unsigned long long) records, (unsigned long long) lines,
+               (unsigned long long) notFound, (unsigned long long) params);
+        printf("time: %.3f s, %.0f lines/s\n", seconds, seconds > 0 ? lines / seconds : 0);
+        printf("latency per record (ns): p50 %llu, p90 %llu, p99 %llu, max %llu\n",
+               (unsigned long long) latencies[records * 50 / 100],
+               (unsigned long long) latencies[records * 90 / 100],
+               (unsigned long long) latencies[records * 99 / 100],
+               (unsigned long long) latencies[records - 1]);
+    }
+    free(latencies);
+    free(data);
+    return 0;
+}
+
+Cmd_Handled Replay_onCmd(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    Param param;
+    // parse params same as a real callback
+    while (Param_next(cursor, &param) != NULL) {
+        params++;
+    }
+    return Cmd_Done;
+}
+
+static void Replay_onNotFound(CmdManager* manager, char* str) {
+    notFound++;
+}
+
+static uint64_t Replay_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+static void Replay_sleepUntil(uint64_t time) {
+    uint64_t now = Replay_now();
+    if (time > now) {
+        struct timespec ts;
+        ts.tv_sec = (time_t) ((time - now) / 1000000000ULL);
+        ts.tv_nsec = (long) ((time - now) % 1000000000ULL);
+        nanosleep(&ts, NULL);
+    }
+}
+
+static int Replay_compare(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*) a;
+    uint64_t y = *(const uint64_t*) b;
+    return x < y ? -1 : x > y;
+}
+
+static uint8_t* Replay_readFile(const char* path, uint32_t* len) {
+    FILE* file = fopen(path, "rb");
+    uint8_t* data;
+    long size;
+
+    if (file == NULL) {
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    data = malloc(size > 0 ? size : 1);
+    if (data != NULL && fread(data, 1, size, file) != (size_t) size) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    *len = (uint32_t) size;
+    return data;
+}
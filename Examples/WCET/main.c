@@ -0,0 +1,216 @@
+/**
+ * @file main.c
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief this example measure worst case time of CmdManager_processLine
+ * with adversarial lines, each line run many times and min, median, p99 and max cycles report,
+ * max of host include interrupts and preemption, so worst case report from p99
+ * Example Configuration
+ * - #define CMD_BOUNDED                         1
+ * - #define CMD_SORT_LIST                       1
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+    #define WCET_CYCLES         1
+#else
+    #define WCET_CYCLES         0
+#endif
+
+#include "Str.h"
+#include "CmdManager.h"
+
+#if !CMD_BOUNDED
+    #error "WCET example need CMD_BOUNDED"
+#endif
+
+#define WCET_ROUNDS             20000
+#define WCET_INPUTS             16
+
+Cmd_Handled WCET_onCmd(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type);
+void WCET_notFound(CmdManager* manager, char* str);
+void WCET_bufferOverflow(CmdManager* manager);
+
+const Cmd CMD_ADC = CMD_INIT("adc", Cmd_Type_Any, WCET_onCmd, WCET_onCmd, WCET_onCmd, WCET_onCmd, WCET_onCmd);
+const Cmd CMD_BAUD = CMD_INIT("baud", Cmd_Type_Any, WCET_onCmd, WCET_onCmd, WCET_onCmd, WCET_onCmd, WCET_onCmd);
+const Cmd CMD_GPIO = CMD_INIT("gpio", Cmd_Type_Any, WCET_onCmd, WCET_onCmd, WCET_onCmd, WCET_onCmd, WCET_onCmd);
+const Cmd CMD_LED = CMD_INIT("led", Cmd_Type_Any, WCET_onCmd, WCET_onCmd, WCET_onCmd, WCET_onCmd, WCET_onCmd);
+const Cmd CMD_PWM = CMD_INIT("pwm", Cmd_Type_Any, WCET_onCmd, WCET_onCmd, WCET_onCmd, WCET_onCmd, WCET_onCmd);
+const Cmd CMD_RESET = CMD_INIT("reset", Cmd_Type_Any, WCET_onCmd, WCET_onCmd, WCET_onCmd, WCET_onCmd, WCET_onCmd);
+const Cmd CMD_STATUS = CMD_INIT("status", Cmd_Type_Any, WCET_onCmd, WCET_onCmd, WCET_onCmd, WCET_onCmd, WCET_onCmd);
+const Cmd CMD_TEMPERATURE = CMD_INIT("temperature", Cmd_Type_Any, WCET_onCmd, WCET_onCmd, WCET_onCmd, WCET_onCmd, WCET_onCmd);
+const Cmd CMD_TEMPERATURES = CMD_INIT("temperatures", Cmd_Type_Any, WCET_onCmd, WCET_onCmd, WCET_onCmd, WCET_onCmd, WCET_onCmd);
+
+const Cmd_Array CMDS[] = {
+    &CMD_ADC,
+    &CMD_BAUD,
+    &CMD_GPIO,
+    &CMD_LED,
+    &CMD_PWM,
+    &CMD_RESET,
+    &CMD_STATUS,
+    &CMD_TEMPERATURE,
+    &CMD_TEMPERATURES,
+};
+const Mem_LenType CMDS_LEN = CMD_ARR_LEN(CMDS);
+
+typedef struct {
+    const char*     Name;
+    char            Line[CMD_LINE_MAX_LEN + 2];
+    Str_LenType     Len;
+    uint64_t        Min;
+    uint64_t        Median;
+    uint64_t        P99;
+    uint64_t        Max;
+} WCET_Input;
+
+static WCET_Input inputs[WCET_INPUTS];
+static uint64_t samples[WCET_ROUNDS];
+static uint8_t inputsLen;
+static uint32_t calls;
+static uint32_t notFound;
+static uint32_t overflow;
+
+static void WCET_add(const char* name, const char* line);
+static void WCET_fill(const char* name, const char* pattern, Str_LenType len);
+static void WCET_run(CmdManager* manager, WCET_Input* input);
+static uint64_t WCET_now(void);
+static int WCET_compare(const void* a, const void* b);
+
+int main(void) {
+    CmdManager manager;
+    char name[CMD_NAME_MAX_LEN + 8];
+    uint64_t worst = 0;
+    uint64_t worstMax = 0;
+    uint8_t index;
+
+    CmdManager_init(&manager, (Cmd_Array*) CMDS, CMDS_LEN);
+    CmdManager_onNotFound(&manager, WCET_notFound);
+    CmdManager_onOverflow(&manager, WCET_bufferOverflow);
+
+    // whitespace and backspace scans
+    WCET_fill("max whitespace", " ", CMD_LINE_MAX_LEN);
+    WCET_fill("all backspace", "\b", CMD_LINE_MAX_LEN);
+    WCET_fill("char backspace", "a\b", CMD_LINE_MAX_LEN);
+    WCET_fill("line max + 1", "a", CMD_LINE_MAX_LEN + 1);
+    // name limits
+    memset(name, 'z', CMD_NAME_MAX_LEN);
+    name[CMD_NAME_MAX_LEN] = '\0';
+    WCET_add("name max", name);
+    name[CMD_NAME_MAX_LEN] = 'z';
+    name[CMD_NAME_MAX_LEN + 1] = '\0';
+    WCET_add("name max + 1", name);
+    // lookup
+    WCET_add("shared prefix", "temperaturez?");
+    WCET_add("mixed case", "TeMpErAtUrEs?");
+    WCET_add("first name", "adc?");
+    WCET_add("last name", "temperatures?");
+    WCET_add("before first", "aaa?");
+    WCET_add("after last", "zzz?");
+    // dispatch
+    WCET_add("max dispatch", "  temperatures   =   1,2,3,4,5,6,7,8,9,10,11,12,13,14,15");
+    WCET_add("short dispatch", "led=1");
+
+    for (index = 0; index < inputsLen; index++) {
+        WCET_run(&manager, &inputs[index]);
+        printf("%-16s len %3u  min %8llu  median %8llu  p99 %8llu  max %8llu\n",
+            inputs[index].Name, (unsigned) inputs[index].Len,
+            (unsigned long long) inputs[index].Min, (unsigned long long) inputs[index].Median,
+            (unsigned long long) inputs[index].P99, (unsigned long long) inputs[index].Max);
+        if (worst < inputs[index].P99) {
+            worst = inputs[index].P99;
+        }
+        if (worstMax < inputs[index].Max) {
+            worstMax = inputs[index].Max;
+        }
+    }
+#if WCET_CYCLES
+    printf("worst case p99 %llu cycles, max %llu cycles\n", (unsigned long long) worst, (unsigned long long) worstMax);
+#else
+    printf("worst case p99 %llu ns, max %llu ns\n", (unsigned long long) worst, (unsigned long long) worstMax);
+#endif
+    printf("calls %u, not found %u, overflow %u\n", calls, notFound, overflow);
+
+    return calls == 0;
+}
+
+Cmd_Handled WCET_onCmd(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    calls++;
+    return Cmd_Done;
+}
+void WCET_notFound(CmdManager* manager, char* str) {
+    notFound++;
+}
+void WCET_bufferOverflow(CmdManager* manager) {
+    overflow++;
+}
+
+static void WCET_add(const char* name, const char* line) {
+    WCET_Input* input = &inputs[inputsLen++];
+    Str_LenType len = (Str_LenType) strlen(line);
+
+    if (len > CMD_LINE_MAX_LEN + 1) {
+        len = CMD_LINE_MAX_LEN + 1;
+    }
+    input->Name = name;
+    memcpy(input->Line, line, len);
+    input->Line[len] = '\0';
+    input->Len = len;
+}
+static void WCET_fill(const char* name, const char* pattern, Str_LenType len) {
+    WCET_Input* input = &inputs[inputsLen++];
+    Str_LenType patternLen = (Str_LenType) strlen(pattern);
+    Str_LenType index;
+
+    input->Name = name;
+    for (index = 0; index < len; index++) {
+        input->Line[index] = pattern[index % patternLen];
+    }
+    input->Line[len] = '\0';
+    input->Len = len;
+}
+static void WCET_run(CmdManager* manager, WCET_Input* input) {
+    char buffer[CMD_LINE_MAX_LEN + 2];
+    Param_Cursor cursor;
+    uint64_t time;
+    uint32_t round;
+
+    for (round = 0; round < WCET_ROUNDS; round++) {
+        // lines modify while process
+        memcpy(buffer, input->Line, input->Len + 1);
+        time = WCET_now();
+        CmdManager_processLine(manager, buffer, input->Len, &cursor);
+        samples[round] = WCET_now() - time;
+    }
+    qsort(samples, WCET_ROUNDS, sizeof(samples[0]), WCET_compare);
+    input->Min = samples[0];
+    input->Median = samples[WCET_ROUNDS / 2];
+    input->P99 = samples[WCET_ROUNDS - WCET_ROUNDS / 100 - 1];
+    input->Max = samples[WCET_ROUNDS - 1];
+}
+
+static uint64_t WCET_now(void) {
+#if WCET_CYCLES
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+#endif
+}
+static int WCET_compare(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*) a;
+    uint64_t y = *(const uint64_t*) b;
+
+    return (x > y) - (x < y);
+}
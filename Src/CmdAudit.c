@@ -0,0 +1,171 @@
+#include "CmdAudit.h"
+
+#if CMD_AUDIT_LOG
+
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/* private functions */
+static void CmdAudit_record(CmdManager* manager, void* args, const Cmd_AuditEvent* event);
+static void* CmdAudit_work(void* args);
+static uint32_t CmdAudit_collect(CmdAudit* audit);
+static Str_LenType CmdAudit_writeHeader(char* record, uint32_t session, int16_t index, uint8_t type, uint8_t result, uint16_t len);
+static uint8_t CmdAudit_write(int fd, const char* data, size_t len);
+/**
+ * @brief open log file and start writer thread
+ *
+ * @param audit
+ * @param path log file, records append to it
+ * @param slots slots of queue
+ * @param events buffer with size * CMD_AUDIT_EVENT_SIZE bytes
+ * @param size number of slots, must be power of 2
+ * @return CmdAudit_Result
+ */
+CmdAudit_Result CmdAudit_start(CmdAudit* audit, const char* path, CmdQueue_Slot* slots, char* events, uint32_t size) {
+    static const char header[CMD_AUDIT_HEADER_SIZE] = {'C', 'M', 'D', 'A', CMD_AUDIT_VERSION, 0, 0, 0};
+
+    audit->Fd = open(path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (audit->Fd < 0) {
+        return CmdAudit_OpenError;
+    }
+    if (lseek(audit->Fd, 0, SEEK_END) == 0) {
+        CmdAudit_write(audit->Fd, header, sizeof(header));
+    }
+    CmdQueue_init(&audit->Queue, slots, events, size, CMD_AUDIT_EVENT_SIZE);
+    audit->Written = 0;
+    audit->Lost = 0;
+    audit->Failed = 0;
+    audit->Running = 1;
+    if (pthread_create(&audit->Thread, NULL, CmdAudit_work, audit) != 0) {
+        close(audit->Fd);
+        return CmdAudit_ThreadError;
+    }
+    return CmdAudit_Ok;
+}
+/**
+ * @brief stop writer thread after write pending records and close log file,
+ * managers must not process commands after it
+ *
+ * @param audit
+ */
+void CmdAudit_stop(CmdAudit* audit) {
+    __atomic_store_n(&audit->Running, 0, __ATOMIC_RELEASE);
+    pthread_join(audit->Thread, NULL);
+    close(audit->Fd);
+}
+/**
+ * @brief set audit hook of manager, copies of manager (sessions of CmdScript or CmdIpc)
+ * share same session
+ *
+ * @param audit
+ * @param session must be valid while manager in use
+ * @param manager
+ * @param id id of session that write in each record
+ */
+void CmdAudit_attach(CmdAudit* audit, CmdAudit_Session* session, CmdManager* manager, uint32_t id) {
+    session->Audit = audit;
+    session->Id = id;
+    CmdManager_onAudit(manager, CmdAudit_record, session);
+}
+/**
+ * @brief return number of dropped records
+ *
+ * @param audit
+ * @return uint32_t
+ */
+uint32_t CmdAudit_dropped(CmdAudit* audit) {
+    return CmdQueue_dropped(&audit->Queue);
+}
+
+static void CmdAudit_record(CmdManager* manager, void* args, const Cmd_AuditEvent* event) {
+    CmdAudit_Session* session = (CmdAudit_Session*) args;
+    char record[CMD_AUDIT_EVENT_SIZE];
+    Str_LenType len;
+
+    (void) manager;
+    len = CmdAudit_writeHeader(record, session->Id, (int16_t) event->Index, event->Type, event->Result, (uint16_t) event->Len);
+    memcpy(&record[len], event->Line, (size_t) event->Len);
+    // queue never block, full queue drop record and count it
+    CmdQueue_push(&session->Audit->Queue, record, len + event->Len);
+}
+static void* CmdAudit_work(void* args) {
+    CmdAudit* audit = (CmdAudit*) args;
+    struct timespec wait = {CMD_AUDIT_FLUSH_MS / 1000, (CMD_AUDIT_FLUSH_MS % 1000) * 1000000L};
+
+    while (__atomic_load_n(&audit->Running, __ATOMIC_ACQUIRE)) {
+        if (CmdAudit_collect(audit) == 0) {
+            nanosleep(&wait, NULL);
+        }
+    }
+    // write pending records
+    while (CmdAudit_collect(audit) != 0) {}
+    return NULL;
+}
+/**
+ * @brief move ready records into batch and write it with single system call
+ */
+static uint32_t CmdAudit_collect(CmdAudit* audit) {
+    uint32_t dropped = CmdQueue_dropped(&audit->Queue);
+    uint32_t count = 0;
+    uint32_t lost = 0;
+    size_t len = 0;
+    Str_LenType recordLen;
+    char* record;
+
+    if (dropped != audit->Lost) {
+        len = (size_t) CmdAudit_writeHeader(audit->Batch, 0, -1, Cmd_Type_None, CmdAudit_Lost, sizeof(uint32_t));
+        dropped -= audit->Lost;
+        memcpy(&audit->Batch[len], &dropped, sizeof(uint32_t));
+        len += sizeof(uint32_t);
+        audit->Lost += dropped;
+        lost = 1;
+    }
+    while ((record = CmdQueue_peek(&audit->Queue, &recordLen)) != NULL &&
+           len + (size_t) recordLen <= CMD_AUDIT_BATCH_SIZE) {
+        memcpy(&audit->Batch[len], record, (size_t) recordLen);
+        len += (size_t) recordLen;
+        CmdQueue_release(&audit->Queue);
+        count++;
+    }
+    if (len != 0) {
+        if (CmdAudit_write(audit->Fd, audit->Batch, len)) {
+            // lost record is not a record of commands
+            audit->Written += count;
+        }
+        else {
+            audit->Failed++;
+        }
+    }
+    return count + lost;
+}
+static Str_LenType CmdAudit_writeHeader(char* record, uint32_t session, int16_t index, uint8_t type, uint8_t result, uint16_t len) {
+    struct timespec ts;
+    uint64_t time;
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+    time = (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+    memcpy(&record[0], &time, sizeof(time));
+    memcpy(&record[8], &session, sizeof(session));
+    memcpy(&record[12], &index, sizeof(index));
+    record[14] = (char) type;
+    record[15] = (char) result;
+    memcpy(&record[16], &len, sizeof(len));
+    return CMD_AUDIT_RECORD_HEADER;
+}
+static uint8_t CmdAudit_write(int fd, const char* data, size_t len) {
+    ssize_t written;
+
+    while (len > 0) {
+        written = write(fd, data, len);
+        if (written <= 0) {
+            return 0;
+        }
+        data += written;
+        len -= (size_t) written;
+    }
+    return 1;
+}
+
+#endif // CMD_AUDIT_LOG
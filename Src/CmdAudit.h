@@ -0,0 +1,124 @@
+/**
+ * @file CmdAudit.h
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief this library can use for write audit log of commands without file I/O in hot path
+ * audit hook of each manager push a binary record into a CmdQueue, background thread
+ * collect records in batches and append them to file
+ * when queue is full new records drop and count, writer add a lost record with number
+ * of dropped records, so gaps of log are visible
+ * log format (host byte order):
+ * - header: "CMDA", version, 3 reserved bytes
+ * - record: time (uint64, ns from epoch), session (uint32), index (int16),
+ *   type (uint8), result (uint8), length (uint16), bytes of statement
+ * - lost record: result is CmdAudit_Lost, index is -1, bytes is number of dropped records (uint32)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _CMD_AUDIT_H_
+#define _CMD_AUDIT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "CmdManager.h"
+#include "CmdQueue.h"
+
+/********************************************************************************/
+/*                              Configuration                                   */
+/********************************************************************************/
+
+/**
+ * @brief enable audit log writer, need CMD_AUDIT, CMD_QUEUE and pthread
+ */
+#ifndef CMD_AUDIT_LOG
+#define CMD_AUDIT_LOG                       0
+#endif
+/**
+ * @brief version of log format
+ */
+#define CMD_AUDIT_VERSION                   1
+/**
+ * @brief size of batch buffer of writer
+ */
+#ifndef CMD_AUDIT_BATCH_SIZE
+#define CMD_AUDIT_BATCH_SIZE                (16 * 1024)
+#endif
+/**
+ * @brief sleep time of writer when queue is empty, in milliseconds
+ */
+#ifndef CMD_AUDIT_FLUSH_MS
+#define CMD_AUDIT_FLUSH_MS                  10
+#endif
+
+/********************************************************************************/
+
+#if CMD_AUDIT_LOG
+
+#if !CMD_AUDIT || !CMD_QUEUE
+    #error "CMD_AUDIT_LOG need CMD_AUDIT and CMD_QUEUE"
+#endif
+
+#include <pthread.h>
+
+/**
+ * @brief size of log header
+ */
+#define CMD_AUDIT_HEADER_SIZE               8
+/**
+ * @brief size of record without bytes of statement
+ */
+#define CMD_AUDIT_RECORD_HEADER             18
+/**
+ * @brief size of each queue line, user must allocate events with this size
+ */
+#define CMD_AUDIT_EVENT_SIZE                (CMD_AUDIT_RECORD_HEADER + CMD_AUDIT_LINE_MAX + 1)
+/**
+ * @brief result of lost record
+ */
+#define CmdAudit_Lost                       0xFF
+
+/**
+ * @brief result of audit functions
+ */
+typedef enum {
+    CmdAudit_Ok                 = 0,    /**< everything is ok */
+    CmdAudit_OpenError          = 1,    /**< can not open file */
+    CmdAudit_ThreadError        = 2,    /**< can not create writer thread */
+} CmdAudit_Result;
+/**
+ * @brief hold properties of audit log
+ */
+typedef struct {
+    CmdQueue            Queue;
+    pthread_t           Thread;
+    uint64_t            Written;        /**< number of written records */
+    uint32_t            Lost;           /**< number of dropped records that reported in log */
+    uint32_t            Failed;         /**< number of batches that write failed, records of them not written */
+    uint32_t            Running;
+    int                 Fd;
+    char                Batch[CMD_AUDIT_BATCH_SIZE];
+} CmdAudit;
+/**
+ * @brief session of a manager, pass to audit hook
+ */
+typedef struct {
+    CmdAudit*           Audit;
+    uint32_t            Id;
+} CmdAudit_Session;
+
+CmdAudit_Result CmdAudit_start(CmdAudit* audit, const char* path, CmdQueue_Slot* slots, char* events, uint32_t size);
+void CmdAudit_stop(CmdAudit* audit);
+void CmdAudit_attach(CmdAudit* audit, CmdAudit_Session* session, CmdManager* manager, uint32_t id);
+uint32_t CmdAudit_dropped(CmdAudit* audit);
+
+#endif // CMD_AUDIT_LOG
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* _CMD_AUDIT_H_ */
@@ -0,0 +1,165 @@
+#include "CmdCapture.h"
+
+/* private variables */
+static const uint8_t CAPTURE_MAGIC[4] = { 'C', 'M', 'D', 'C' };
+/* private defines */
+#define __VARINT_MAX_LEN        5
+/* private functions */
+static uint8_t CmdCapture_writeVarint(uint8_t* buf, uint32_t value);
+static uint8_t CmdCapture_readVarint(CmdCapture_Reader* reader, uint32_t* value);
+#if CMD_CAPTURE
+    static void CmdCapture_onCapture(CmdManager* manager, void* args, const char* data, Str_LenType len);
+#endif
+/**
+ * @brief initialize capture writer, header write with first record
+ *
+ * @param capture
+ * @param write output of log, ex: file or flash writer
+ * @param time time source in microseconds
+ * @param args pass to write function
+ */
+void CmdCapture_init(CmdCapture* capture, CmdCapture_WriteFn write, CmdCapture_TimeFn time, void* args) {
+    capture->write = write;
+    capture->time = time;
+    capture->Args = args;
+    capture->LastTime = 0;
+    capture->Records = 0;
+    capture->Dropped = 0;
+    capture->Started = 0;
+    capture->Failed = 0;
+}
+/**
+ * @brief append record to log
+ *
+ * @param capture
+ * @param data raw input bytes
+ * @param len
+ * @return CmdCapture_Result
+ */
+CmdCapture_Result CmdCapture_write(CmdCapture* capture, const char* data, uint32_t len) {
+    uint8_t head[__VARINT_MAX_LEN * 2];
+    uint8_t headLen;
+    uint32_t now;
+
+    if (capture->Failed) {
+        // part of a record may be written, next records can not decode
+        capture->Dropped++;
+        return CmdCapture_WriteError;
+    }
+    now = capture->time();
+    if (!capture->Started) {
+        uint8_t header[CMD_CAPTURE_HEADER_SIZE] = {
+            CAPTURE_MAGIC[0], CAPTURE_MAGIC[1], CAPTURE_MAGIC[2], CAPTURE_MAGIC[3],
+            CMD_CAPTURE_VERSION, 0, 0, 0,
+        };
+        if (capture->write(capture->Args, header, sizeof(header)) != 0) {
+            capture->Dropped++;
+            return CmdCapture_WriteError;
+        }
+        capture->LastTime = now;
+        capture->Started = 1;
+    }
+    // unsigned subtraction handle overflow of time source
+    headLen = CmdCapture_writeVarint(head, now - capture->LastTime);
+    headLen += CmdCapture_writeVarint(&head[headLen], len);
+    if (capture->write(capture->Args, head, headLen) != 0 ||
+        capture->write(capture->Args, (const uint8_t*) data, len) != 0) {
+        capture->Failed = 1;
+        capture->Dropped++;
+        return CmdCapture_WriteError;
+    }
+    capture->LastTime = now;
+    capture->Records++;
+    return CmdCapture_Ok;
+}
+#if CMD_CAPTURE
+/**
+ * @brief capture all input of manager
+ *
+ * @param capture
+ * @param manager
+ */
+void CmdCapture_attach(CmdCapture* capture, CmdManager* manager) {
+    CmdManager_onCapture(manager, CmdCapture_onCapture, capture);
+}
+#endif // CMD_CAPTURE
+/**
+ * @brief open log for read, check header
+ *
+ * @param reader
+ * @param data content of log
+ * @param len
+ * @return CmdCapture_Result
+ */
+CmdCapture_Result CmdCapture_open(CmdCapture_Reader* reader, const uint8_t* data, uint32_t len) {
+    reader->Data = data;
+    reader->Len = len;
+    reader->Pos = CMD_CAPTURE_HEADER_SIZE;
+    reader->Time = 0;
+    if (len < CMD_CAPTURE_HEADER_SIZE ||
+        Mem_compare(data, CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC)) != 0 ||
+        data[4] != CMD_CAPTURE_VERSION) {
+        reader->Pos = len;
+        return CmdCapture_InvalidHeader;
+    }
+    return CmdCapture_Ok;
+}
+/**
+ * @brief read next record of log
+ *
+ * @param reader
+ * @param record
+ * @return CmdCapture_Result CmdCapture_End if no more records
+ */
+CmdCapture_Result CmdCapture_next(CmdCapture_Reader* reader, CmdCapture_Record* record) {
+    uint32_t delta;
+    uint32_t len;
+
+    if (reader->Pos >= reader->Len) {
+        return CmdCapture_End;
+    }
+    if (!CmdCapture_readVarint(reader, &delta) ||
+        !CmdCapture_readVarint(reader, &len) ||
+        reader->Len - reader->Pos < len) {
+        reader->Pos = reader->Len;
+        return CmdCapture_Truncated;
+    }
+    reader->Time += delta;
+    record->Data = (const char*) &reader->Data[reader->Pos];
+    record->Len = len;
+    record->Time = reader->Time;
+    reader->Pos += len;
+    return CmdCapture_Ok;
+}
+
+static uint8_t CmdCapture_writeVarint(uint8_t* buf, uint32_t value) {
+    uint8_t len = 0;
+
+    while (value >= 0x80) {
+        buf[len++] = (uint8_t) (value | 0x80);
+        value >>= 7;
+    }
+    buf[len++] = (uint8_t) value;
+    return len;
+}
+static uint8_t CmdCapture_readVarint(CmdCapture_Reader* reader, uint32_t* value) {
+    uint8_t shift = 0;
+    uint8_t byte;
+
+    *value = 0;
+    do {
+        if (reader->Pos >= reader->Len || shift >= __VARINT_MAX_LEN * 7) {
+            return 0;
+        }
+        byte = reader->Data[reader->Pos++];
+        *value |= (uint32_t) (byte & 0x7F) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    return 1;
+}
+#if CMD_CAPTURE
+static void CmdCapture_onCapture(CmdManager* manager, void* args, const char* data, Str_LenType len) {
+    (void) manager;
+    CmdCapture_write((CmdCapture*) args, data, (uint32_t) len);
+}
+#endif // CMD_CAPTURE
@@ -0,0 +1,102 @@
+/**
+ * @file CmdCapture.h
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief this library can use for record input of CmdManager into compact binary log
+ * and read it back for replay
+ * log format:
+ * - header: "CMDC", version, flags, 2 reserved bytes
+ * - record: varint delta time in microseconds, varint length, raw bytes
+ * after first failed record write, log stop and next records count as dropped
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _CMD_CAPTURE_H_
+#define _CMD_CAPTURE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "CmdManager.h"
+
+/********************************************************************************/
+/*                              Configuration                                   */
+/********************************************************************************/
+
+/**
+ * @brief version of log format
+ */
+#define CMD_CAPTURE_VERSION                 1
+/**
+ * @brief size of log header
+ */
+#define CMD_CAPTURE_HEADER_SIZE             8
+
+/********************************************************************************/
+
+/**
+ * @brief result of capture functions
+ */
+typedef enum {
+    CmdCapture_Ok               = 0,    /**< everything is ok */
+    CmdCapture_End              = 1,    /**< no more records */
+    CmdCapture_WriteError       = 2,    /**< write function failed */
+    CmdCapture_InvalidHeader    = 3,    /**< magic or version not match */
+    CmdCapture_Truncated        = 4,    /**< last record is incomplete */
+} CmdCapture_Result;
+/**
+ * @brief write data into log, return 0 on success
+ */
+typedef uint8_t (*CmdCapture_WriteFn) (void* args, const uint8_t* data, uint32_t len);
+/**
+ * @brief return current time in microseconds, can overflow
+ */
+typedef uint32_t (*CmdCapture_TimeFn) (void);
+/**
+ * @brief hold properties of capture writer
+ */
+typedef struct {
+    CmdCapture_WriteFn  write;
+    CmdCapture_TimeFn   time;
+    void*               Args;
+    uint32_t            LastTime;
+    uint32_t            Records;        /**< number of written records */
+    uint32_t            Dropped;        /**< number of records that write failed */
+    uint8_t             Started;        /**< header written */
+    uint8_t             Failed;         /**< a record write failed, log stop to keep records aligned */
+} CmdCapture;
+/**
+ * @brief hold properties of capture reader
+ */
+typedef struct {
+    const uint8_t*      Data;
+    uint32_t            Len;
+    uint32_t            Pos;
+    uint64_t            Time;           /**< time of last record from start of capture */
+} CmdCapture_Reader;
+/**
+ * @brief single record of log
+ */
+typedef struct {
+    const char*         Data;
+    uint32_t            Len;
+    uint64_t            Time;           /**< microseconds from start of capture */
+} CmdCapture_Record;
+
+void CmdCapture_init(CmdCapture* capture, CmdCapture_WriteFn write, CmdCapture_TimeFn time, void* args);
+CmdCapture_Result CmdCapture_write(CmdCapture* capture, const char* data, uint32_t len);
+#if CMD_CAPTURE
+    void CmdCapture_attach(CmdCapture* capture, CmdManager* manager);
+#endif
+
+CmdCapture_Result CmdCapture_open(CmdCapture_Reader* reader, const uint8_t* data, uint32_t len);
+CmdCapture_Result CmdCapture_next(CmdCapture_Reader* reader, CmdCapture_Record* record);
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* _CMD_CAPTURE_H_ */
@@ -0,0 +1,497 @@
+#include "CmdEncoder.h"
+
+/* private variables */
+static const char DIGITS_PAIR[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+static const char DIGITS_HEX[] = "0123456789ABCDEF";
+static const uint32_t POW10[] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+};
+/* private defines */
+#define __space(ENC)            ((ENC)->Size - (ENC)->Pos)
+#define __ptr(ENC)              (&(ENC)->Buffer[(ENC)->Pos])
+/* private functions */
+static CmdEncoder_Result CmdEncoder_write(CmdEncoder* encoder, const char* str, Str_LenType len);
+static CmdEncoder_Result CmdEncoder_separator(CmdEncoder* encoder);
+static CmdEncoder_Result CmdEncoder_fail(CmdEncoder* encoder, CmdEncoder_Result result);
+static uint8_t CmdEncoder_isPlain(CmdEncoder* encoder, const char* value);
+static uint8_t CmdEncoder_uintLen(uint32_t value);
+static void CmdEncoder_uintFix(char* str, uint32_t value, uint8_t len);
+static CmdEncoder_Result CmdEncoder_uint(CmdEncoder* encoder, uint32_t value, uint8_t len);
+/**
+ * @brief initialize encoder for a manager
+ *
+ * @param encoder
+ * @param manager source of StartWith, PatternTypes, ParamSeparator and EndWith
+ * @param buffer output buffer
+ * @param size size of output buffer
+ */
+void CmdEncoder_init(CmdEncoder* encoder, CmdManager* manager, char* buffer, Str_LenType size) {
+    encoder->Manager = manager;
+    encoder->Buffer = buffer;
+    encoder->Size = size;
+    CmdEncoder_reset(encoder);
+}
+/**
+ * @brief discard all encoded commands
+ *
+ * @param encoder
+ */
+void CmdEncoder_reset(CmdEncoder* encoder) {
+    encoder->Len = 0;
+    encoder->Pos = 0;
+    encoder->Params = 0;
+    encoder->PatternLen = 0;
+    encoder->Result = CmdEncoder_Ok;
+}
+/**
+ * @brief return length of committed commands
+ *
+ * @param encoder
+ * @return Str_LenType
+ */
+Str_LenType CmdEncoder_len(CmdEncoder* encoder) {
+    return encoder->Len;
+}
+/**
+ * @brief start new command, write StartWith, cmd name and type pattern
+ * type that cmd not support reject with CmdEncoder_InvalidValue, receiver can not run it
+ *
+ * @param encoder
+ * @param cmd
+ * @param type single type, Cmd_Type_Unknown not valid
+ * @return CmdEncoder_Result
+ */
+CmdEncoder_Result CmdEncoder_begin(CmdEncoder* encoder, const Cmd* cmd, Cmd_Type type) {
+    CmdManager* manager = encoder->Manager;
+    Cmd_Str* pattern = NULL;
+
+    encoder->Pos = encoder->Len;
+    encoder->Params = 0;
+    encoder->PatternLen = 0;
+    encoder->Result = CmdEncoder_Ok;
+    if ((cmd->Types.Flags & (uint8_t) type) == 0) {
+        return CmdEncoder_fail(encoder, CmdEncoder_InvalidValue);
+    }
+    // find pattern of type
+    if (manager->PatternTypes) {
+        uint8_t typeIndex;
+        for (typeIndex = 0; typeIndex < CMD_PATTERN_TYPE_LEN; typeIndex++) {
+            if (type == (Cmd_Type) (1 << typeIndex)) {
+                pattern = manager->PatternTypes->Patterns[typeIndex];
+                break;
+            }
+        }
+        if (pattern == NULL) {
+            return CmdEncoder_fail(encoder, CmdEncoder_InvalidType);
+        }
+    }
+    // write cmd header
+    if (manager->StartWith) {
+        CmdEncoder_write(encoder, manager->StartWith->Text, manager->StartWith->Len);
+    }
+    CmdEncoder_write(encoder, cmd->CmdName.Text, cmd->CmdName.Len);
+    if (pattern) {
+        CmdEncoder_write(encoder, pattern->Text, pattern->Len);
+        encoder->PatternLen = (uint8_t) pattern->Len;
+    }
+    return encoder->Result;
+}
+/**
+ * @brief write signed decimal param
+ *
+ * @param encoder
+ * @param value
+ * @return CmdEncoder_Result
+ */
+CmdEncoder_Result CmdEncoder_number(CmdEncoder* encoder, int32_t value) {
+    uint32_t num = (uint32_t) value;
+
+    if (CmdEncoder_separator(encoder) != CmdEncoder_Ok) {
+        return encoder->Result;
+    }
+    if (value < 0) {
+        if (CmdEncoder_write(encoder, "-", 1) != CmdEncoder_Ok) {
+            return encoder->Result;
+        }
+        num = 0U - num;
+    }
+    return CmdEncoder_uint(encoder, num, CmdEncoder_uintLen(num));
+}
+/**
+ * @brief write hex param with 0x prefix
+ *
+ * @param encoder
+ * @param value
+ * @return CmdEncoder_Result
+ */
+CmdEncoder_Result CmdEncoder_numberHex(CmdEncoder* encoder, uint32_t value) {
+    uint8_t len = 1;
+    char* str;
+
+    while (len < 8 && (value >> (len << 2)) != 0) {
+        len++;
+    }
+    if (CmdEncoder_separator(encoder) != CmdEncoder_Ok ||
+        CmdEncoder_write(encoder, "0x", 2) != CmdEncoder_Ok) {
+        return encoder->Result;
+    }
+    if (__space(encoder) < len) {
+        return CmdEncoder_fail(encoder, CmdEncoder_Overflow);
+    }
+    str = __ptr(encoder) + len;
+    encoder->Pos += len;
+    while (len-- > 0) {
+        *--str = DIGITS_HEX[value & 0x0F];
+        value >>= 4;
+    }
+    return CmdEncoder_Ok;
+}
+/**
+ * @brief write binary param with 0b prefix
+ *
+ * @param encoder
+ * @param value
+ * @return CmdEncoder_Result
+ */
+CmdEncoder_Result CmdEncoder_numberBinary(CmdEncoder* encoder, uint32_t value) {
+    uint8_t len = 1;
+    char* str;
+
+    while (len < 32 && (value >> len) != 0) {
+        len++;
+    }
+    if (CmdEncoder_separator(encoder) != CmdEncoder_Ok ||
+        CmdEncoder_write(encoder, "0b", 2) != CmdEncoder_Ok) {
+        return encoder->Result;
+    }
+    if (__space(encoder) < len) {
+        return CmdEncoder_fail(encoder, CmdEncoder_Overflow);
+    }
+    str = __ptr(encoder) + len;
+    encoder->Pos += len;
+    while (len-- > 0) {
+        *--str = (char) ('0' + (value & 0x01));
+        value >>= 1;
+    }
+    return CmdEncoder_Ok;
+}
+/**
+ * @brief write float param with fixed number of fraction digits
+ * values that integer part not fit in 32-bit, NaN and Inf are invalid
+ *
+ * @param encoder
+ * @param value
+ * @param precision number of fraction digits, 0 means CMD_ENCODER_FLOAT_PRECISION
+ * @return CmdEncoder_Result
+ */
+CmdEncoder_Result CmdEncoder_float(CmdEncoder* encoder, float value, uint8_t precision) {
+    uint32_t integer;
+    uint32_t fraction;
+    float scaled;
+
+    if (precision == 0) {
+        precision = CMD_ENCODER_FLOAT_PRECISION;
+    }
+    else if (precision > 9) {
+        precision = 9;
+    }
+    if (CmdEncoder_separator(encoder) != CmdEncoder_Ok) {
+        return encoder->Result;
+    }
+    // NaN compare always false
+    if (!(value > -4294967295.0f && value < 4294967295.0f)) {
+        return CmdEncoder_fail(encoder, CmdEncoder_InvalidValue);
+    }
+    if (value < 0) {
+        if (CmdEncoder_write(encoder, "-", 1) != CmdEncoder_Ok) {
+            return encoder->Result;
+        }
+        value = -value;
+    }
+    integer = (uint32_t) value;
+    scaled = (value - (float) integer) * (float) POW10[precision] + 0.5f;
+    fraction = (uint32_t) scaled;
+    // carry rounding into integer part
+    if (fraction >= POW10[precision]) {
+        fraction -= POW10[precision];
+        integer++;
+    }
+    if (CmdEncoder_uint(encoder, integer, CmdEncoder_uintLen(integer)) != CmdEncoder_Ok ||
+        CmdEncoder_write(encoder, ".", 1) != CmdEncoder_Ok) {
+        return encoder->Result;
+    }
+    return CmdEncoder_uint(encoder, fraction, precision);
+}
+/**
+ * @brief write state param, high or low
+ *
+ * @param encoder
+ * @param value
+ * @return CmdEncoder_Result
+ */
+CmdEncoder_Result CmdEncoder_state(CmdEncoder* encoder, uint8_t value) {
+    if (CmdEncoder_separator(encoder) != CmdEncoder_Ok) {
+        return encoder->Result;
+    }
+    return value ? CmdEncoder_write(encoder, "high", 4) : CmdEncoder_write(encoder, "low", 3);
+}
+/**
+ * @brief write state key param, on or off
+ *
+ * @param encoder
+ * @param value
+ * @return CmdEncoder_Result
+ */
+CmdEncoder_Result CmdEncoder_stateKey(CmdEncoder* encoder, uint8_t value) {
+    if (CmdEncoder_separator(encoder) != CmdEncoder_Ok) {
+        return encoder->Result;
+    }
+    return value ? CmdEncoder_write(encoder, "on", 2) : CmdEncoder_write(encoder, "off", 3);
+}
+/**
+ * @brief write boolean param, true or false
+ *
+ * @param encoder
+ * @param value
+ * @return CmdEncoder_Result
+ */
+CmdEncoder_Result CmdEncoder_boolean(CmdEncoder* encoder, uint8_t value) {
+    if (CmdEncoder_separator(encoder) != CmdEncoder_Ok) {
+        return encoder->Result;
+    }
+    return value ? CmdEncoder_write(encoder, "true", 4) : CmdEncoder_write(encoder, "false", 5);
+}
+/**
+ * @brief write string param between quotes
+ * parser has no escape, so quote, backslash, separators, EndWith characters
+ * and backspace reject with CmdEncoder_InvalidValue
+ *
+ * @param encoder
+ * @param value
+ * @return CmdEncoder_Result
+ */
+CmdEncoder_Result CmdEncoder_string(CmdEncoder* encoder, const char* value) {
+    if (!CmdEncoder_isPlain(encoder, value)) {
+        return CmdEncoder_fail(encoder, CmdEncoder_InvalidValue);
+    }
+    if (CmdEncoder_separator(encoder) != CmdEncoder_Ok ||
+        CmdEncoder_write(encoder, "\"", 1) != CmdEncoder_Ok ||
+        CmdEncoder_write(encoder, value, Str_len(value)) != CmdEncoder_Ok) {
+        return encoder->Result;
+    }
+    return CmdEncoder_write(encoder, "\"", 1);
+}
+/**
+ * @brief write null param
+ *
+ * @param encoder
+ * @return CmdEncoder_Result
+ */
+CmdEncoder_Result CmdEncoder_null(CmdEncoder* encoder) {
+    if (CmdEncoder_separator(encoder) != CmdEncoder_Ok) {
+        return encoder->Result;
+    }
+    return CmdEncoder_write(encoder, "null", 4);
+}
+/**
+ * @brief write param as is, without any conversion
+ *
+ * @param encoder
+ * @param value
+ * @param len
+ * @return CmdEncoder_Result
+ */
+CmdEncoder_Result CmdEncoder_raw(CmdEncoder* encoder, const char* value, Str_LenType len) {
+    if (CmdEncoder_separator(encoder) != CmdEncoder_Ok) {
+        return encoder->Result;
+    }
+    return CmdEncoder_write(encoder, value, len);
+}
+/**
+ * @brief write param based on Param_Value type
+ *
+ * @param encoder
+ * @param value
+ * @return CmdEncoder_Result
+ */
+CmdEncoder_Result CmdEncoder_param(CmdEncoder* encoder, const Param_Value* value) {
+    switch (value->Type) {
+        case Param_ValueType_Number:
+            return CmdEncoder_number(encoder, value->Number);
+        case Param_ValueType_NumberHex:
+            return CmdEncoder_numberHex(encoder, value->NumberHex);
+        case Param_ValueType_NumberBinary:
+            return CmdEncoder_numberBinary(encoder, value->NumberBinary);
+        case Param_ValueType_Float:
+            return CmdEncoder_float(encoder, value->Float, 0);
+        case Param_ValueType_State:
+            return CmdEncoder_state(encoder, value->State);
+        case Param_ValueType_StateKey:
+            return CmdEncoder_stateKey(encoder, value->StateKey);
+        case Param_ValueType_Boolean:
+            return CmdEncoder_boolean(encoder, value->Boolean);
+        case Param_ValueType_String:
+            return CmdEncoder_string(encoder, value->String);
+        case Param_ValueType_Null:
+            return CmdEncoder_null(encoder);
+        case Param_ValueType_Unknown:
+            // unknown values write without quotes, same characters of strings break parse
+            if (!CmdEncoder_isPlain(encoder, value->Unknown)) {
+                return CmdEncoder_fail(encoder, CmdEncoder_InvalidValue);
+            }
+            return CmdEncoder_raw(encoder, value->Unknown, Str_len(value->Unknown));
+        default:
+            return CmdEncoder_fail(encoder, CmdEncoder_InvalidValue);
+    }
+}
+/**
+ * @brief write EndWith and commit current command
+ * on error current command discard
+ *
+ * @param encoder
+ * @return CmdEncoder_Result
+ */
+CmdEncoder_Result CmdEncoder_end(CmdEncoder* encoder) {
+    if (encoder->Result == CmdEncoder_Ok &&
+        CmdEncoder_write(encoder, encoder->Manager->EndWith->Text, encoder->Manager->EndWith->Len) == CmdEncoder_Ok) {
+        encoder->Len = encoder->Pos;
+        // keep output null terminated if there is space
+        if (encoder->Len < encoder->Size) {
+            encoder->Buffer[encoder->Len] = '\0';
+        }
+    }
+    encoder->Pos = encoder->Len;
+    return encoder->Result;
+}
+/**
+ * @brief encode single command with params
+ *
+ * @param encoder
+ * @param cmd
+ * @param type
+ * @param params
+ * @param len number of params
+ * @return CmdEncoder_Result
+ */
+CmdEncoder_Result CmdEncoder_encode(CmdEncoder* encoder, const Cmd* cmd, Cmd_Type type, const Param_Value* params, Param_LenType len) {
+    if (CmdEncoder_begin(encoder, cmd, type) == CmdEncoder_Ok) {
+        while (len-- > 0 && CmdEncoder_param(encoder, params++) == CmdEncoder_Ok) {}
+    }
+    return CmdEncoder_end(encoder);
+}
+/**
+ * @brief encode multiple commands into buffer, stop on first error
+ *
+ * @param encoder
+ * @param items
+ * @param len
+ * @return Mem_LenType number of encoded commands
+ */
+Mem_LenType CmdEncoder_encodeBatch(CmdEncoder* encoder, const CmdEncoder_Item* items, Mem_LenType len) {
+    Mem_LenType count = 0;
+
+    while (count < len &&
+           CmdEncoder_encode(encoder, items->Cmd, items->Type, items->Params, items->Len) == CmdEncoder_Ok) {
+        items++;
+        count++;
+    }
+    return count;
+}
+
+static CmdEncoder_Result CmdEncoder_write(CmdEncoder* encoder, const char* str, Str_LenType len) {
+    if (encoder->Result != CmdEncoder_Ok) {
+        return encoder->Result;
+    }
+    if (__space(encoder) < len) {
+        return CmdEncoder_fail(encoder, CmdEncoder_Overflow);
+    }
+    Mem_copy(__ptr(encoder), str, len);
+    encoder->Pos += len;
+    return CmdEncoder_Ok;
+}
+static CmdEncoder_Result CmdEncoder_separator(CmdEncoder* encoder) {
+    if (encoder->Params++ > 0) {
+        return CmdEncoder_write(encoder, &encoder->Manager->ParamSeparator, 1);
+    }
+    // execute pattern is empty, params must separate from cmd name
+    else if (encoder->PatternLen == 0) {
+        return CmdEncoder_write(encoder, " ", 1);
+    }
+    return encoder->Result;
+}
+static CmdEncoder_Result CmdEncoder_fail(CmdEncoder* encoder, CmdEncoder_Result result) {
+    if (encoder->Result == CmdEncoder_Ok) {
+        encoder->Result = result;
+    }
+    return encoder->Result;
+}
+static uint8_t CmdEncoder_isPlain(CmdEncoder* encoder, const char* value) {
+    CmdManager* manager = encoder->Manager;
+    Str_LenType index;
+    char c;
+
+    while ((c = *value++) != '\0') {
+        if (c == '"' || c == '\\' || c == manager->ParamSeparator) {
+            return 0;
+        }
+    #if CMD_STATEMENT
+        if (c == manager->StatementSeparator) {
+            return 0;
+        }
+    #endif // CMD_STATEMENT
+    #if CMD_REMOVE_BACKSPACE
+        if (c == '\b') {
+            return 0;
+        }
+    #endif // CMD_REMOVE_BACKSPACE
+        for (index = 0; index < manager->EndWith->Len; index++) {
+            if (c == manager->EndWith->Text[index]) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+static uint8_t CmdEncoder_uintLen(uint32_t value) {
+    uint8_t len = 1;
+
+    while (len < 10 && value >= POW10[len]) {
+        len++;
+    }
+    return len;
+}
+static void CmdEncoder_uintFix(char* str, uint32_t value, uint8_t len) {
+    str += len;
+    // write two digits per step
+    while (len >= 2) {
+        const char* pair = &DIGITS_PAIR[(value % 100) << 1];
+        value /= 100;
+        *--str = pair[1];
+        *--str = pair[0];
+        len -= 2;
+    }
+    if (len) {
+        *--str = (char) ('0' + (value % 10));
+    }
+}
+static CmdEncoder_Result CmdEncoder_uint(CmdEncoder* encoder, uint32_t value, uint8_t len) {
+    if (encoder->Result != CmdEncoder_Ok) {
+        return encoder->Result;
+    }
+    if (__space(encoder) < len) {
+        return CmdEncoder_fail(encoder, CmdEncoder_Overflow);
+    }
+    CmdEncoder_uintFix(__ptr(encoder), value, len);
+    encoder->Pos += len;
+    return CmdEncoder_Ok;
+}
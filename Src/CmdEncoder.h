@@ -0,0 +1,94 @@
+/**
+ * @file CmdEncoder.h
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief this library can use for build outgoing command strings
+ * it's use same Cmd and Cmd_PatternTypes of a CmdManager, so output always
+ * match with StartWith, PatternTypes, ParamSeparator and EndWith of manager
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _CMD_ENCODER_H_
+#define _CMD_ENCODER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "CmdManager.h"
+
+/********************************************************************************/
+/*                              Configuration                                   */
+/********************************************************************************/
+
+/**
+ * @brief default number of fraction digits for float params, valid range 1 ~ 9
+ */
+#ifndef CMD_ENCODER_FLOAT_PRECISION
+#define CMD_ENCODER_FLOAT_PRECISION         3
+#endif
+
+/********************************************************************************/
+
+/**
+ * @brief result of encoder functions
+ */
+typedef enum {
+    CmdEncoder_Ok               = 0,    /**< everything is ok */
+    CmdEncoder_Overflow         = 1,    /**< buffer has no space for command */
+    CmdEncoder_InvalidType      = 2,    /**< cmd type not support by manager */
+    CmdEncoder_InvalidValue     = 3,    /**< param value can not encode */
+} CmdEncoder_Result;
+/**
+ * @brief hold properties of encoder
+ * each command write after last committed command, and commit on CmdEncoder_end
+ * on any error current command discard and buffer keep previous commands
+ */
+typedef struct {
+    CmdManager*         Manager;
+    char*               Buffer;
+    Str_LenType         Size;
+    Str_LenType         Len;            /**< length of committed commands */
+    Str_LenType         Pos;            /**< write position of current command */
+    Param_LenType       Params;         /**< number of params in current command */
+    CmdEncoder_Result   Result;         /**< first error of current command */
+    uint8_t             PatternLen;     /**< length of current command pattern */
+} CmdEncoder;
+/**
+ * @brief single command of batch
+ */
+typedef struct {
+    const Cmd*          Cmd;
+    const Param_Value*  Params;
+    Param_LenType       Len;
+    Cmd_Type            Type;
+} CmdEncoder_Item;
+
+void CmdEncoder_init(CmdEncoder* encoder, CmdManager* manager, char* buffer, Str_LenType size);
+void CmdEncoder_reset(CmdEncoder* encoder);
+Str_LenType CmdEncoder_len(CmdEncoder* encoder);
+
+CmdEncoder_Result CmdEncoder_begin(CmdEncoder* encoder, const Cmd* cmd, Cmd_Type type);
+CmdEncoder_Result CmdEncoder_number(CmdEncoder* encoder, int32_t value);
+CmdEncoder_Result CmdEncoder_numberHex(CmdEncoder* encoder, uint32_t value);
+CmdEncoder_Result CmdEncoder_numberBinary(CmdEncoder* encoder, uint32_t value);
+CmdEncoder_Result CmdEncoder_float(CmdEncoder* encoder, float value, uint8_t precision);
+CmdEncoder_Result CmdEncoder_state(CmdEncoder* encoder, uint8_t value);
+CmdEncoder_Result CmdEncoder_stateKey(CmdEncoder* encoder, uint8_t value);
+CmdEncoder_Result CmdEncoder_boolean(CmdEncoder* encoder, uint8_t value);
+CmdEncoder_Result CmdEncoder_string(CmdEncoder* encoder, const char* value);
+CmdEncoder_Result CmdEncoder_null(CmdEncoder* encoder);
+CmdEncoder_Result CmdEncoder_raw(CmdEncoder* encoder, const char* value, Str_LenType len);
+CmdEncoder_Result CmdEncoder_param(CmdEncoder* encoder, const Param_Value* value);
+CmdEncoder_Result CmdEncoder_end(CmdEncoder* encoder);
+
+CmdEncoder_Result CmdEncoder_encode(CmdEncoder* encoder, const Cmd* cmd, Cmd_Type type, const Param_Value* params, Param_LenType len);
+Mem_LenType CmdEncoder_encodeBatch(CmdEncoder* encoder, const CmdEncoder_Item* items, Mem_LenType len);
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* _CMD_ENCODER_H_ */
@@ -0,0 +1,321 @@
+#include "CmdImage.h"
+
+#if CMD_TABLE
+
+#if CMD_IMAGE_MMAP
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif // CMD_IMAGE_MMAP
+
+/* private defines */
+#define __IMAGE_MAGIC           0x49444D43UL    /* "CMDI" in little endian */
+#define __FNV_OFFSET            2166136261UL
+#define __FNV_PRIME             16777619UL
+/* Keys, NameLens, Types, CallbackMasks and Options */
+#define __TABLE_BYTES           (4 + (CMD_OPTIONS != 0))
+/* private functions */
+static uint32_t CmdImage_hash(uint32_t hash, const void* data, uint32_t len);
+static uint32_t CmdImage_hashConfig(void);
+static uint16_t CmdImage_callbacksLen(const Cmd_Table* table);
+static uint16_t CmdImage_namesLen(const Cmd_Table* table);
+static uint8_t CmdImage_bits(uint8_t mask);
+static uint32_t CmdImage_contentSize(uint16_t len, uint16_t callbacks, uint16_t names);
+/**
+ * @brief return size of image of table
+ *
+ * @param table
+ * @return uint32_t
+ */
+uint32_t CmdImage_size(const Cmd_Table* table) {
+    return CmdImage_contentSize(table->Len, CmdImage_callbacksLen(table), CmdImage_namesLen(table));
+}
+/**
+ * @brief save table into image
+ *
+ * @param table table that build with CmdTable_build or loaded from image, must have lookup
+ * @param symbols all callbacks of table must be in symbols
+ * @param tag user defined value that check on load
+ * @param buffer must be aligned for uint32_t
+ * @param size
+ * @return CmdImage_Result
+ */
+CmdImage_Result CmdImage_save(const Cmd_Table* table, const CmdImage_Symbols* symbols, uint32_t tag, void* buffer, uint32_t size) {
+    CmdImage_Header* header = (CmdImage_Header*) buffer;
+    uint16_t callbacks = CmdImage_callbacksLen(table);
+    uint16_t names = CmdImage_namesLen(table);
+    uint32_t imageSize = CmdImage_contentSize(table->Len, callbacks, names);
+    uint16_t* arrays = (uint16_t*) (header + 1);
+    uint16_t* callbackIds;
+    uint8_t* bytes;
+    uint16_t index;
+
+    if (table->Lookup == NULL) {
+        return CmdImage_NoLookup;
+    }
+    if (imageSize > size) {
+        return CmdImage_Overflow;
+    }
+    Mem_copy(arrays, table->NameOffsets, table->Len * sizeof(uint16_t));
+    arrays += table->Len;
+    Mem_copy(arrays, table->CallbackOffsets, table->Len * sizeof(uint16_t));
+    arrays += table->Len;
+    Mem_copy(arrays, table->Lookup, table->Len * sizeof(uint16_t));
+    arrays += table->Len;
+    // callbacks of table convert to index of symbols
+    callbackIds = arrays;
+    for (index = 0; index < callbacks; index++) {
+        Cmd_CallbackFn fn = table->Symbols[table->CallbackIds[index]];
+        uint16_t symbol = 0;
+        while (symbol < symbols->Len && symbols->Fns[symbol] != fn) {
+            symbol++;
+        }
+        if (symbol == symbols->Len) {
+            return CmdImage_UnknownSymbol;
+        }
+        callbackIds[index] = symbol;
+    }
+    bytes = (uint8_t*) &callbackIds[callbacks];
+    Mem_copy(bytes, table->Keys, table->Len);
+    bytes += table->Len;
+    Mem_copy(bytes, table->NameLens, table->Len);
+    bytes += table->Len;
+    Mem_copy(bytes, table->Types, table->Len);
+    bytes += table->Len;
+    Mem_copy(bytes, table->CallbackMasks, table->Len);
+    bytes += table->Len;
+#if CMD_OPTIONS
+    Mem_copy(bytes, table->Options, table->Len);
+    bytes += table->Len;
+#endif
+    Mem_copy(bytes, table->Names, names);
+
+    header->Magic = __IMAGE_MAGIC;
+    header->Version = CMD_IMAGE_VERSION;
+    header->HeaderSize = sizeof(CmdImage_Header);
+    header->Size = imageSize;
+    header->ConfigHash = CmdImage_hashConfig();
+    header->SymbolsHash = CmdImage_hashSymbols(symbols);
+    header->ContentHash = CmdImage_hash(__FNV_OFFSET, header + 1, imageSize - sizeof(CmdImage_Header));
+    header->Tag = tag;
+    header->Len = table->Len;
+    header->CallbacksLen = callbacks;
+    header->NamesLen = names;
+    header->Reserved = 0;
+    return CmdImage_Ok;
+}
+/**
+ * @brief validate image and set table arrays into image, no copy happen,
+ * so image must be valid while table in use, Cmds of table is NULL
+ *
+ * @param table
+ * @param symbols same symbols of save
+ * @param tag same tag of save
+ * @param image must be aligned for uint32_t
+ * @param size
+ * @return CmdImage_Result
+ */
+CmdImage_Result CmdImage_load(Cmd_Table* table, const CmdImage_Symbols* symbols, uint32_t tag, const void* image, uint32_t size) {
+    const CmdImage_Header* header = (const CmdImage_Header*) image;
+    const uint16_t* arrays = (const uint16_t*) (header + 1);
+    const uint8_t* bytes;
+    uint16_t index;
+
+    if (size < sizeof(CmdImage_Header) ||
+        header->Magic != __IMAGE_MAGIC ||
+        header->Version != CMD_IMAGE_VERSION ||
+        header->HeaderSize != sizeof(CmdImage_Header) ||
+        header->Size > size ||
+        header->Size != CmdImage_contentSize(header->Len, header->CallbacksLen, header->NamesLen) ||
+        header->Len > (Cmd_LenType) -1) {
+        return CmdImage_InvalidHeader;
+    }
+    if (header->ConfigHash != CmdImage_hashConfig()) {
+        return CmdImage_ConfigMismatch;
+    }
+    if (header->SymbolsHash != CmdImage_hashSymbols(symbols)) {
+        return CmdImage_SymbolsMismatch;
+    }
+    if (header->Tag != tag) {
+        return CmdImage_TagMismatch;
+    }
+    if (header->ContentHash != CmdImage_hash(__FNV_OFFSET, header + 1, header->Size - sizeof(CmdImage_Header))) {
+        return CmdImage_Corrupted;
+    }
+    table->Cmds = NULL;
+    table->Symbols = symbols->Fns;
+    table->SymbolsLen = symbols->Len;
+    table->Len = (Cmd_LenType) header->Len;
+    table->NameOffsets = arrays;
+    arrays += header->Len;
+    table->CallbackOffsets = arrays;
+    arrays += header->Len;
+    table->Lookup = arrays;
+    arrays += header->Len;
+    table->CallbackIds = arrays;
+    bytes = (const uint8_t*) &arrays[header->CallbacksLen];
+    table->Keys = bytes;
+    bytes += header->Len;
+    table->NameLens = bytes;
+    bytes += header->Len;
+    table->Types = bytes;
+    bytes += header->Len;
+    table->CallbackMasks = bytes;
+    bytes += header->Len;
+#if CMD_OPTIONS
+    table->Options = bytes;
+    bytes += header->Len;
+#endif
+    table->Names = (const char*) bytes;
+    // offsets out of arrays can not pass hashes, but image may come from untrusted storage
+    for (index = 0; index < header->CallbacksLen; index++) {
+        if (table->CallbackIds[index] >= symbols->Len) {
+            table->Len = 0;
+            return CmdImage_Corrupted;
+        }
+    }
+    for (index = 0; index < header->Len; index++) {
+        if ((uint32_t) table->NameOffsets[index] + table->NameLens[index] > header->NamesLen ||
+            (uint32_t) table->CallbackOffsets[index] + CmdImage_bits(table->CallbackMasks[index]) > header->CallbacksLen ||
+            table->Lookup[index] >= header->Len) {
+            table->Len = 0;
+            return CmdImage_Corrupted;
+        }
+    }
+    return CmdImage_Ok;
+}
+/**
+ * @brief return hash of symbol names, change of names, order or count reject old images
+ *
+ * @param symbols
+ * @return uint32_t
+ */
+uint32_t CmdImage_hashSymbols(const CmdImage_Symbols* symbols) {
+    uint32_t hash = __FNV_OFFSET;
+    uint16_t index;
+
+    for (index = 0; index < symbols->Len; index++) {
+        const char* name = symbols->Names[index];
+        // include null terminator as separator
+        hash = CmdImage_hash(hash, name, (uint32_t) Str_len(name) + 1);
+    }
+    return hash;
+}
+#if CMD_IMAGE_MMAP
+/**
+ * @brief map image file and load it, bytes of file after image unmap
+ *
+ * @param table
+ * @param symbols
+ * @param tag
+ * @param path
+ * @return CmdImage_Result
+ */
+CmdImage_Result CmdImage_map(Cmd_Table* table, const CmdImage_Symbols* symbols, uint32_t tag, const char* path) {
+    CmdImage_Result result;
+    struct stat st;
+    void* image;
+    size_t used;
+    long page;
+    int fd;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return CmdImage_OpenError;
+    }
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return CmdImage_OpenError;
+    }
+    if (st.st_size < (off_t) sizeof(CmdImage_Header) || st.st_size > (off_t) 0xFFFFFFFFUL) {
+        close(fd);
+        return CmdImage_InvalidHeader;
+    }
+    image = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (image == MAP_FAILED) {
+        return CmdImage_OpenError;
+    }
+    result = CmdImage_load(table, symbols, tag, image, (uint32_t) st.st_size);
+    if (result != CmdImage_Ok) {
+        munmap(image, (size_t) st.st_size);
+        return result;
+    }
+    // keep only pages of image, so CmdImage_unmap can use size of header
+    page = sysconf(_SC_PAGESIZE);
+    if (page > 0) {
+        used = (((const CmdImage_Header*) image)->Size + (size_t) page - 1) & ~((size_t) page - 1);
+        if (used < (size_t) st.st_size) {
+            munmap((uint8_t*) image + used, (size_t) st.st_size - used);
+        }
+    }
+    return result;
+}
+/**
+ * @brief unmap image of table that loaded with CmdImage_map, size of mapping is size of image
+ *
+ * @param table
+ */
+void CmdImage_unmap(Cmd_Table* table) {
+    const CmdImage_Header* header = ((const CmdImage_Header*) table->NameOffsets) - 1;
+
+    munmap((void*) header, header->Size);
+    table->Len = 0;
+}
+#endif // CMD_IMAGE_MMAP
+
+static uint32_t CmdImage_hash(uint32_t hash, const void* data, uint32_t len) {
+    const uint8_t* ptr = (const uint8_t*) data;
+
+    while (len-- > 0) {
+        hash ^= *ptr++;
+        hash *= __FNV_PRIME;
+    }
+    return hash;
+}
+static uint32_t CmdImage_hashConfig(void) {
+    const uint32_t config[] = {
+        CMD_TYPE_LEN,
+        CMD_TYPE_UNKNOWN,
+        CMD_MULTI_CALLBACK,
+        CMD_OPTIONS,
+        CMD_CASE_MODE,
+        sizeof(Cmd_LenType),
+        sizeof(CmdImage_Header),
+        // byte order and hash of names
+        0x01020304UL,
+        CmdTable_hash("cmd", 3),
+    };
+    return CmdImage_hash(__FNV_OFFSET, config, sizeof(config));
+}
+static uint16_t CmdImage_callbacksLen(const Cmd_Table* table) {
+    if (table->Len == 0) {
+        return 0;
+    }
+    // callbacks of last command after its offset
+    return (uint16_t) (table->CallbackOffsets[table->Len - 1] + CmdImage_bits(table->CallbackMasks[table->Len - 1]));
+}
+static uint8_t CmdImage_bits(uint8_t mask) {
+    uint8_t len = 0;
+
+    while (mask) {
+        mask &= (uint8_t) (mask - 1);
+        len++;
+    }
+    return len;
+}
+static uint16_t CmdImage_namesLen(const Cmd_Table* table) {
+    if (table->Len == 0) {
+        return 0;
+    }
+    return (uint16_t) (table->NameOffsets[table->Len - 1] + table->NameLens[table->Len - 1]);
+}
+static uint32_t CmdImage_contentSize(uint16_t len, uint16_t callbacks, uint16_t names) {
+    return sizeof(CmdImage_Header) +
+           (uint32_t) len * (3 * sizeof(uint16_t) + __TABLE_BYTES) +
+           (uint32_t) callbacks * sizeof(uint16_t) +
+           names;
+}
+
+#endif // CMD_TABLE
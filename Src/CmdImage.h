@@ -0,0 +1,101 @@
+/**
+ * @file CmdImage.h
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief this library can use for save Cmd_Table into binary image and load it
+ * without build, image arrays use in place, so image can be memory mapped or in flash
+ * callbacks store as index of application symbol table, image reject if version,
+ * configuration, symbols, tag or content not match, or offsets of arrays out of image
+ * lookup of table store in image, so loaded table use binary search too
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _CMD_IMAGE_H_
+#define _CMD_IMAGE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "CmdManager.h"
+
+/********************************************************************************/
+/*                              Configuration                                   */
+/********************************************************************************/
+
+/**
+ * @brief version of image format
+ */
+#define CMD_IMAGE_VERSION                   2
+/**
+ * @brief enable CmdImage_map and CmdImage_unmap, need POSIX mmap
+ */
+#ifndef CMD_IMAGE_MMAP
+#define CMD_IMAGE_MMAP                      0
+#endif
+
+/********************************************************************************/
+
+#if CMD_TABLE
+
+/**
+ * @brief result of image functions
+ */
+typedef enum {
+    CmdImage_Ok                 = 0,    /**< everything is ok */
+    CmdImage_Overflow           = 1,    /**< buffer has no space for image */
+    CmdImage_UnknownSymbol      = 2,    /**< callback of table not found in symbols */
+    CmdImage_InvalidHeader      = 3,    /**< magic, version or size not match */
+    CmdImage_ConfigMismatch     = 4,    /**< image build with other configuration */
+    CmdImage_SymbolsMismatch    = 5,    /**< symbols changed after image build */
+    CmdImage_TagMismatch        = 6,    /**< tag of application not match */
+    CmdImage_Corrupted          = 7,    /**< content hash not match */
+    CmdImage_OpenError          = 8,    /**< can not open or map file */
+    CmdImage_NoLookup           = 9,    /**< table has no lookup, image always keep lookup */
+} CmdImage_Result;
+/**
+ * @brief symbol table of application, names only use for validate image,
+ * order of symbols is callback id
+ */
+typedef struct {
+    const char* const*      Names;
+    const Cmd_CallbackFn*   Fns;
+    uint16_t                Len;
+} CmdImage_Symbols;
+/**
+ * @brief header of image
+ */
+typedef struct {
+    uint32_t                Magic;
+    uint16_t                Version;
+    uint16_t                HeaderSize;
+    uint32_t                Size;               /**< size of image include header */
+    uint32_t                ConfigHash;         /**< hash of configuration that effect layout */
+    uint32_t                SymbolsHash;        /**< hash of symbol names */
+    uint32_t                ContentHash;        /**< hash of content after header */
+    uint32_t                Tag;                /**< user defined, ex: build id of plugins */
+    uint16_t                Len;                /**< number of commands */
+    uint16_t                CallbacksLen;       /**< number of callback ids */
+    uint16_t                NamesLen;           /**< size of packed names */
+    uint16_t                Reserved;
+} CmdImage_Header;
+
+uint32_t CmdImage_size(const Cmd_Table* table);
+CmdImage_Result CmdImage_save(const Cmd_Table* table, const CmdImage_Symbols* symbols, uint32_t tag, void* buffer, uint32_t size);
+CmdImage_Result CmdImage_load(Cmd_Table* table, const CmdImage_Symbols* symbols, uint32_t tag, const void* image, uint32_t size);
+uint32_t CmdImage_hashSymbols(const CmdImage_Symbols* symbols);
+
+#if CMD_IMAGE_MMAP
+    CmdImage_Result CmdImage_map(Cmd_Table* table, const CmdImage_Symbols* symbols, uint32_t tag, const char* path);
+    void CmdImage_unmap(Cmd_Table* table);
+#endif // CMD_IMAGE_MMAP
+
+#endif // CMD_TABLE
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* _CMD_IMAGE_H_ */
@@ -0,0 +1,443 @@
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+#include "CmdIpc.h"
+
+#if CMD_IPC
+
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#if (CMD_IPC_RING_SIZE & (CMD_IPC_RING_SIZE - 1)) != 0
+    #error "CMD_IPC_RING_SIZE must be power of 2"
+#endif
+#if CMD_IPC_LINE_SIZE + 2 > CMD_IPC_RING_SIZE
+    #error "CMD_IPC_LINE_SIZE must fit in CMD_IPC_RING_SIZE"
+#endif
+
+/* "CMDP" in little endian */
+#define CMD_IPC_MAGIC           0x50444D43
+#define CMD_IPC_VERSION         1
+/* size of length of each request record */
+#define CMD_IPC_RECORD_HEADER   2
+
+#define __used(R)               (__atomic_load_n(&(R)->Head, __ATOMIC_ACQUIRE) - __atomic_load_n(&(R)->Tail, __ATOMIC_ACQUIRE))
+#define __free(R)               (CMD_IPC_RING_SIZE - __used(R))
+
+/**
+ * @brief state of channel
+ */
+typedef enum {
+    CmdIpc_State_Free           = 0,
+    CmdIpc_State_Attached       = 1,
+    CmdIpc_State_Closing        = 2,    /**< client left, server discard requests and free channel */
+    CmdIpc_State_Attaching      = 3,    /**< client own channel, Pid and Epoch not ready */
+} CmdIpc_State;
+
+/* private functions */
+static uint32_t CmdIpc_process(CmdIpc_Server* server);
+static void CmdIpc_copyIn(CmdIpc_Ring* ring, uint32_t pos, const void* data, uint32_t len);
+static void CmdIpc_copyOut(CmdIpc_Ring* ring, uint32_t pos, void* data, uint32_t len);
+static void CmdIpc_signal(uint32_t* word, uint32_t* waiters);
+static uint8_t CmdIpc_wait(uint32_t* word, uint32_t* waiters, uint32_t value, int32_t timeout, struct timespec* start);
+/**
+ * @brief create shared memory and initialize sessions
+ *
+ * @param server
+ * @param name name of shared memory object, ex: "/cmd"
+ * @param manager configured manager, used as template of sessions
+ * @return CmdIpc_Result
+ */
+CmdIpc_Result CmdIpc_open(CmdIpc_Server* server, const char* name, CmdManager* manager) {
+    CmdIpc_Shared* shared;
+    uint8_t index;
+    int fd;
+
+    fd = shm_open(name, O_CREAT | O_RDWR, 0600);
+    if (fd < 0) {
+        return CmdIpc_OpenError;
+    }
+    if (ftruncate(fd, sizeof(CmdIpc_Shared)) != 0) {
+        close(fd);
+        return CmdIpc_OpenError;
+    }
+    shared = (CmdIpc_Shared*) mmap(NULL, sizeof(CmdIpc_Shared), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (shared == MAP_FAILED) {
+        return CmdIpc_OpenError;
+    }
+    memset(shared, 0, sizeof(CmdIpc_Shared));
+    shared->Version = CMD_IPC_VERSION;
+    // clients check magic, so write it last
+    __atomic_store_n(&shared->Magic, CMD_IPC_MAGIC, __ATOMIC_RELEASE);
+
+    server->Shared = shared;
+    server->Manager = manager;
+    server->onSession = (CmdIpc_SessionFn) NULL;
+    server->Name = name;
+    for (index = 0; index < CMD_IPC_CHANNELS; index++) {
+        server->Sessions[index].Channel = &shared->Channels[index];
+        server->Sessions[index].Epoch = 0;
+    }
+    return CmdIpc_Ok;
+}
+/**
+ * @brief unmap and remove shared memory, attached clients keep their mapping
+ *
+ * @param server
+ */
+void CmdIpc_close(CmdIpc_Server* server) {
+    munmap(server->Shared, sizeof(CmdIpc_Shared));
+    shm_unlink(server->Name);
+    server->Shared = NULL;
+}
+/**
+ * @brief set callback of new sessions, it can set limits and cache of each session
+ *
+ * @param server
+ * @param fn
+ */
+void CmdIpc_onSession(CmdIpc_Server* server, CmdIpc_SessionFn fn) {
+    server->onSession = fn;
+}
+/**
+ * @brief process requests of all channels, sleep until a request arrive if nothing ready
+ *
+ * @param server
+ * @param timeout max wait in milliseconds, 0 for no wait, -1 for wait forever
+ * @return uint32_t number of processed lines
+ */
+uint32_t CmdIpc_poll(CmdIpc_Server* server, int32_t timeout) {
+    CmdIpc_Shared* shared = server->Shared;
+    struct timespec start;
+    uint32_t doorbell;
+    uint32_t count;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (;;) {
+        // read doorbell before process, request after it change doorbell and wake up wait
+        doorbell = __atomic_load_n(&shared->Doorbell, __ATOMIC_SEQ_CST);
+        count = CmdIpc_process(server);
+        if (count != 0 || timeout == 0) {
+            return count;
+        }
+        if (!CmdIpc_wait(&shared->Doorbell, &shared->Waiters, doorbell, timeout, &start)) {
+            return CmdIpc_process(server);
+        }
+    }
+}
+/**
+ * @brief write response of current command into response ring of session,
+ * server never wait for client, response drop if ring has no space
+ *
+ * @param manager session manager that pass to callback
+ * @param data
+ * @param len
+ * @return CmdIpc_Result
+ */
+CmdIpc_Result CmdIpc_respond(CmdManager* manager, const char* data, Str_LenType len) {
+    CmdIpc_Channel* channel = ((CmdIpc_Session*) manager)->Channel;
+    CmdIpc_Ring* ring = &channel->Response;
+    uint32_t head = ring->Head;
+
+    if (__free(ring) < (uint32_t) len) {
+        __atomic_add_fetch(&channel->Dropped, (uint32_t) len, __ATOMIC_RELAXED);
+        return CmdIpc_Full;
+    }
+    CmdIpc_copyIn(ring, head, data, len);
+    __atomic_store_n(&ring->Head, head + len, __ATOMIC_SEQ_CST);
+    CmdIpc_signal(&ring->Seq, &ring->Waiters);
+    return CmdIpc_Ok;
+}
+/**
+ * @brief attach to server and take a free channel, channels of dead processes reclaim
+ *
+ * @param client
+ * @param name name of shared memory object
+ * @return CmdIpc_Result
+ */
+CmdIpc_Result CmdIpcClient_connect(CmdIpc_Client* client, const char* name) {
+    CmdIpc_Shared* shared;
+    CmdIpc_Channel* channel;
+    struct stat st;
+    uint32_t state;
+    uint8_t index;
+    int fd;
+
+    fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) {
+        return CmdIpc_OpenError;
+    }
+    if (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(CmdIpc_Shared)) {
+        close(fd);
+        return CmdIpc_OpenError;
+    }
+    shared = (CmdIpc_Shared*) mmap(NULL, sizeof(CmdIpc_Shared), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (shared == MAP_FAILED) {
+        return CmdIpc_OpenError;
+    }
+    if (__atomic_load_n(&shared->Magic, __ATOMIC_ACQUIRE) != CMD_IPC_MAGIC ||
+        shared->Version != CMD_IPC_VERSION) {
+        munmap(shared, sizeof(CmdIpc_Shared));
+        return CmdIpc_InvalidHeader;
+    }
+    for (index = 0; index < CMD_IPC_CHANNELS; index++) {
+        channel = &shared->Channels[index];
+        state = CmdIpc_State_Free;
+        if (__atomic_compare_exchange_n(&channel->State, &state, CmdIpc_State_Attaching, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            // client is reader of responses, drop responses of previous client
+            __atomic_store_n(&channel->Response.Tail, __atomic_load_n(&channel->Response.Head, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+            channel->Pid = (int32_t) getpid();
+            channel->Dropped = 0;
+            __atomic_add_fetch(&channel->Epoch, 1, __ATOMIC_RELEASE);
+            // Pid of previous owner can not seen as owner of attached channel
+            __atomic_store_n(&channel->State, CmdIpc_State_Attached, __ATOMIC_RELEASE);
+            client->Shared = shared;
+            client->Channel = channel;
+            return CmdIpc_Ok;
+        }
+        if (state == CmdIpc_State_Attached && kill((pid_t) channel->Pid, 0) != 0 && errno == ESRCH) {
+            // owner died without close, server free it on next poll
+            __atomic_compare_exchange_n(&channel->State, &state, CmdIpc_State_Closing, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+        }
+    }
+    munmap(shared, sizeof(CmdIpc_Shared));
+    return CmdIpc_Busy;
+}
+/**
+ * @brief leave channel and unmap shared memory
+ *
+ * @param client
+ */
+void CmdIpcClient_close(CmdIpc_Client* client) {
+    __atomic_store_n(&client->Channel->State, CmdIpc_State_Closing, __ATOMIC_RELEASE);
+    CmdIpc_signal(&client->Shared->Doorbell, &client->Shared->Waiters);
+    munmap(client->Shared, sizeof(CmdIpc_Shared));
+    client->Shared = NULL;
+    client->Channel = NULL;
+}
+/**
+ * @brief push line into request ring and wake server
+ *
+ * @param client
+ * @param line line without EndWith
+ * @param len
+ * @param timeout max wait for space in milliseconds, 0 for no wait, -1 for wait forever
+ * @return CmdIpc_Result
+ */
+CmdIpc_Result CmdIpcClient_send(CmdIpc_Client* client, const char* line, Str_LenType len, int32_t timeout) {
+    CmdIpc_Ring* ring = &client->Channel->Request;
+    struct timespec start;
+    uint32_t head = ring->Head;
+    uint32_t seq;
+    uint16_t recordLen = (uint16_t) len;
+
+    if (len < 0 || len >= CMD_IPC_LINE_SIZE) {
+        return CmdIpc_TooLong;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (;;) {
+        seq = __atomic_load_n(&ring->Seq, __ATOMIC_SEQ_CST);
+        if (__free(ring) >= (uint32_t) len + CMD_IPC_RECORD_HEADER) {
+            break;
+        }
+        if (timeout == 0 || !CmdIpc_wait(&ring->Seq, &ring->Waiters, seq, timeout, &start)) {
+            return CmdIpc_Full;
+        }
+    }
+    CmdIpc_copyIn(ring, head, &recordLen, CMD_IPC_RECORD_HEADER);
+    CmdIpc_copyIn(ring, head + CMD_IPC_RECORD_HEADER, line, len);
+    __atomic_store_n(&ring->Head, head + CMD_IPC_RECORD_HEADER + len, __ATOMIC_SEQ_CST);
+    CmdIpc_signal(&client->Shared->Doorbell, &client->Shared->Waiters);
+    return CmdIpc_Ok;
+}
+/**
+ * @brief read available response bytes
+ *
+ * @param client
+ * @param buffer
+ * @param size
+ * @param timeout max wait for data in milliseconds, 0 for no wait, -1 for wait forever
+ * @return uint32_t number of read bytes, 0 on timeout
+ */
+uint32_t CmdIpcClient_receive(CmdIpc_Client* client, char* buffer, uint32_t size, int32_t timeout) {
+    CmdIpc_Ring* ring = &client->Channel->Response;
+    struct timespec start;
+    uint32_t tail = ring->Tail;
+    uint32_t used;
+    uint32_t seq;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (;;) {
+        seq = __atomic_load_n(&ring->Seq, __ATOMIC_SEQ_CST);
+        used = __used(ring);
+        if (used != 0) {
+            break;
+        }
+        if (timeout == 0 || !CmdIpc_wait(&ring->Seq, &ring->Waiters, seq, timeout, &start)) {
+            return 0;
+        }
+    }
+    if (used > size) {
+        used = size;
+    }
+    CmdIpc_copyOut(ring, tail, buffer, used);
+    __atomic_store_n(&ring->Tail, tail + used, __ATOMIC_RELEASE);
+    return used;
+}
+
+static uint32_t CmdIpc_process(CmdIpc_Server* server) {
+    CmdIpc_Session* session;
+    CmdIpc_Channel* channel;
+    CmdIpc_Ring* ring;
+    Param_Cursor cursor;
+    uint32_t count = 0;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t epoch;
+    uint32_t state;
+    uint16_t len;
+    uint8_t index;
+
+    for (index = 0; index < CMD_IPC_CHANNELS; index++) {
+        session = &server->Sessions[index];
+        channel = session->Channel;
+        ring = &channel->Request;
+        state = __atomic_load_n(&channel->State, __ATOMIC_ACQUIRE);
+        if (state == CmdIpc_State_Closing) {
+            // drop requests of left client and free channel
+            __atomic_store_n(&ring->Tail, __atomic_load_n(&ring->Head, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+            session->Epoch = 0;
+            __atomic_store_n(&channel->State, CmdIpc_State_Free, __ATOMIC_RELEASE);
+            continue;
+        }
+        if (state != CmdIpc_State_Attached) {
+            continue;
+        }
+        epoch = __atomic_load_n(&channel->Epoch, __ATOMIC_ACQUIRE);
+        if (session->Epoch != epoch) {
+            // new client, start new session
+            session->Manager = *server->Manager;
+            CmdManager_resetInput(&session->Manager);
+        #if CMD_RATE_LIMIT
+            // arrays of template would share between sessions
+            session->Manager.Limits = NULL;
+            session->Manager.LimitsLen = 0;
+        #endif
+        #if CMD_CACHE
+            session->Manager.Cache = NULL;
+            session->Manager.CacheLen = 0;
+            session->Manager.Recording = NULL;
+        #endif
+        #if CMD_STATS
+            CmdManager_resetStats(&session->Manager);
+        #endif
+            session->Epoch = epoch;
+            if (server->onSession) {
+                server->onSession(server, session, index);
+            }
+        }
+        tail = ring->Tail;
+        head = __atomic_load_n(&ring->Head, __ATOMIC_ACQUIRE);
+        if (head == tail) {
+            continue;
+        }
+        if (head - tail > CMD_IPC_RING_SIZE) {
+            // client wrote invalid head, drop all pending requests
+            tail = head;
+        }
+        while (tail != head) {
+            // client publish whole record at once
+            if (head - tail < CMD_IPC_RECORD_HEADER) {
+                tail = head;
+                break;
+            }
+            CmdIpc_copyOut(ring, tail, &len, CMD_IPC_RECORD_HEADER);
+            if (len >= CMD_IPC_LINE_SIZE || CMD_IPC_RECORD_HEADER + (uint32_t) len > head - tail) {
+                // corrupted ring, drop all pending requests
+                tail = head;
+                break;
+            }
+            // copy out, client can not change line while process
+            CmdIpc_copyOut(ring, tail + CMD_IPC_RECORD_HEADER, session->Line, len);
+            session->Line[len] = '\0';
+            tail += CMD_IPC_RECORD_HEADER + len;
+        #if CMD_CAPTURE
+            CmdManager_captureLine(&session->Manager, session->Line, (Str_LenType) len);
+        #endif
+            CmdManager_processLine(&session->Manager, session->Line, (Str_LenType) len, &cursor);
+            count++;
+        }
+        __atomic_store_n(&ring->Tail, tail, __ATOMIC_SEQ_CST);
+        // wake client that wait for space
+        CmdIpc_signal(&ring->Seq, &ring->Waiters);
+    }
+    return count;
+}
+static void CmdIpc_copyIn(CmdIpc_Ring* ring, uint32_t pos, const void* data, uint32_t len) {
+    uint32_t offset = pos & (CMD_IPC_RING_SIZE - 1);
+    uint32_t first = CMD_IPC_RING_SIZE - offset;
+
+    if (first >= len) {
+        memcpy(&ring->Data[offset], data, len);
+    }
+    else {
+        memcpy(&ring->Data[offset], data, first);
+        memcpy(ring->Data, (const uint8_t*) data + first, len - first);
+    }
+}
+static void CmdIpc_copyOut(CmdIpc_Ring* ring, uint32_t pos, void* data, uint32_t len) {
+    uint32_t offset = pos & (CMD_IPC_RING_SIZE - 1);
+    uint32_t first = CMD_IPC_RING_SIZE - offset;
+
+    if (first >= len) {
+        memcpy(data, &ring->Data[offset], len);
+    }
+    else {
+        memcpy(data, &ring->Data[offset], first);
+        memcpy((uint8_t*) data + first, ring->Data, len - first);
+    }
+}
+/**
+ * @brief change futex word and wake waiters, system call only when a waiter exists
+ */
+static void CmdIpc_signal(uint32_t* word, uint32_t* waiters) {
+    __atomic_add_fetch(word, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(waiters, __ATOMIC_SEQ_CST) != 0) {
+        syscall(SYS_futex, word, FUTEX_WAKE, INT32_MAX, NULL, NULL, 0);
+    }
+}
+/**
+ * @brief sleep while futex word is value, return 0 if timeout expired
+ */
+static uint8_t CmdIpc_wait(uint32_t* word, uint32_t* waiters, uint32_t value, int32_t timeout, struct timespec* start) {
+    struct timespec now;
+    struct timespec remain;
+    int64_t elapsed;
+
+    if (timeout > 0) {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        elapsed = (int64_t) (now.tv_sec - start->tv_sec) * 1000000000LL + (now.tv_nsec - start->tv_nsec);
+        elapsed = (int64_t) timeout * 1000000LL - elapsed;
+        if (elapsed <= 0) {
+            return 0;
+        }
+        remain.tv_sec = (time_t) (elapsed / 1000000000LL);
+        remain.tv_nsec = (long) (elapsed % 1000000000LL);
+    }
+    __atomic_add_fetch(waiters, 1, __ATOMIC_SEQ_CST);
+    syscall(SYS_futex, word, FUTEX_WAIT, value, timeout > 0 ? &remain : NULL, NULL, 0);
+    __atomic_sub_fetch(waiters, 1, __ATOMIC_SEQ_CST);
+    return 1;
+}
+
+#endif // CMD_IPC
@@ -0,0 +1,166 @@
+/**
+ * @file CmdIpc.h
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief this library can use for feed commands of local processes into CmdManager on Linux
+ * server create a shared memory object with fixed channels, each client attach to a free channel
+ * and get own session (copy of manager), each channel have request and response ring
+ * arrays of each command (limits and cache) not copy, sessions start without them
+ * and CmdIpc_onSession can set own arrays of each session
+ * - request: client push lines as records, server copy each line and process it
+ * - response: callbacks write bytes with CmdIpc_respond, client read them as a stream
+ * waiting side sleep on futex, writer wake it only when a waiter exists,
+ * so busy traffic don't need any system call
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _CMD_IPC_H_
+#define _CMD_IPC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "CmdManager.h"
+
+/********************************************************************************/
+/*                              Configuration                                   */
+/********************************************************************************/
+
+/**
+ * @brief enable shared memory transport, need Linux shm, futex and pthread
+ */
+#ifndef CMD_IPC
+#define CMD_IPC                             0
+#endif
+/**
+ * @brief max number of clients that attach at same time
+ */
+#ifndef CMD_IPC_CHANNELS
+#define CMD_IPC_CHANNELS                    8
+#endif
+/**
+ * @brief size of each ring in bytes, must be power of 2
+ */
+#ifndef CMD_IPC_RING_SIZE
+#define CMD_IPC_RING_SIZE                   4096
+#endif
+/**
+ * @brief max length of each line
+ */
+#ifndef CMD_IPC_LINE_SIZE
+#define CMD_IPC_LINE_SIZE                   256
+#endif
+/**
+ * @brief size of cache line, positions of reader and writer keep in separate lines
+ */
+#ifndef CMD_IPC_CACHE_LINE
+#define CMD_IPC_CACHE_LINE                  64
+#endif
+
+/********************************************************************************/
+
+#if CMD_IPC
+
+/**
+ * @brief result of ipc functions
+ */
+typedef enum {
+    CmdIpc_Ok                   = 0,    /**< everything is ok */
+    CmdIpc_OpenError            = 1,    /**< can not open or map shared memory */
+    CmdIpc_InvalidHeader        = 2,    /**< shared memory not created by same version */
+    CmdIpc_Busy                 = 3,    /**< no free channel */
+    CmdIpc_Full                 = 4,    /**< ring has no space */
+    CmdIpc_TooLong              = 5,    /**< line not fit in CMD_IPC_LINE_SIZE */
+} CmdIpc_Result;
+/**
+ * @brief single producer single consumer byte ring in shared memory
+ */
+typedef struct {
+    uint32_t            Head;           /**< write position */
+    uint32_t            Seq;            /**< futex word, increase on each write or read */
+    uint32_t            Waiters;        /**< number of sleeping readers or writers */
+    uint8_t             Padding0[CMD_IPC_CACHE_LINE - 3 * sizeof(uint32_t)];
+    uint32_t            Tail;           /**< read position */
+    uint8_t             Padding1[CMD_IPC_CACHE_LINE - sizeof(uint32_t)];
+    uint8_t             Data[CMD_IPC_RING_SIZE];
+} CmdIpc_Ring;
+/**
+ * @brief channel of a client
+ */
+typedef struct {
+    uint32_t            State;          /**< 0 free, 1 attached, 2 closing, 3 attaching */
+    uint32_t            Epoch;          /**< increase on each attach, server start new session */
+    int32_t             Pid;            /**< process of client */
+    uint32_t            Dropped;        /**< response bytes that dropped because ring was full */
+    uint8_t             Padding[CMD_IPC_CACHE_LINE - 4 * sizeof(uint32_t)];
+    CmdIpc_Ring         Request;
+    CmdIpc_Ring         Response;
+} CmdIpc_Channel;
+/**
+ * @brief layout of shared memory
+ */
+typedef struct {
+    uint32_t            Magic;
+    uint32_t            Version;
+    uint32_t            Doorbell;       /**< futex word of server, increase on each request */
+    uint32_t            Waiters;        /**< server is sleeping */
+    uint8_t             Padding[CMD_IPC_CACHE_LINE - 4 * sizeof(uint32_t)];
+    CmdIpc_Channel      Channels[CMD_IPC_CHANNELS];
+} CmdIpc_Shared;
+/**
+ * @brief session of a channel, manager must be first member
+ */
+typedef struct {
+    CmdManager          Manager;
+    CmdIpc_Channel*     Channel;
+    uint32_t            Epoch;          /**< epoch of attached client, 0 for none */
+    char                Line[CMD_IPC_LINE_SIZE];
+} CmdIpc_Session;
+typedef struct __CmdIpc_Server CmdIpc_Server;
+/**
+ * @brief call when a client attach and its session start from template
+ *
+ * @param server
+ * @param session new session
+ * @param index index of channel
+ */
+typedef void (*CmdIpc_SessionFn) (CmdIpc_Server* server, CmdIpc_Session* session, uint8_t index);
+/**
+ * @brief hold properties of server
+ */
+struct __CmdIpc_Server {
+    CmdIpc_Shared*      Shared;
+    CmdManager*         Manager;        /**< template of sessions */
+    CmdIpc_SessionFn    onSession;
+    const char*         Name;
+    CmdIpc_Session      Sessions[CMD_IPC_CHANNELS];
+};
+/**
+ * @brief hold properties of client
+ */
+typedef struct {
+    CmdIpc_Shared*      Shared;
+    CmdIpc_Channel*     Channel;
+} CmdIpc_Client;
+
+CmdIpc_Result CmdIpc_open(CmdIpc_Server* server, const char* name, CmdManager* manager);
+void CmdIpc_close(CmdIpc_Server* server);
+void CmdIpc_onSession(CmdIpc_Server* server, CmdIpc_SessionFn fn);
+uint32_t CmdIpc_poll(CmdIpc_Server* server, int32_t timeout);
+CmdIpc_Result CmdIpc_respond(CmdManager* manager, const char* data, Str_LenType len);
+
+CmdIpc_Result CmdIpcClient_connect(CmdIpc_Client* client, const char* name);
+void CmdIpcClient_close(CmdIpc_Client* client);
+CmdIpc_Result CmdIpcClient_send(CmdIpc_Client* client, const char* line, Str_LenType len, int32_t timeout);
+uint32_t CmdIpcClient_receive(CmdIpc_Client* client, char* buffer, uint32_t size, int32_t timeout);
+
+#endif // CMD_IPC
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* _CMD_IPC_H_ */
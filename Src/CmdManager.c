@@ -49,6 +49,15 @@ const Cmd_Str CMD_END_WITH = CMD_STR_INIT(CMD_DEFAULT_END_WITH);
 #else
     #define __search            Mem_linearSearch
 #endif
+#if CMD_CACHE && !CMD_TYPE_GET
+    #error "CMD_CACHE need CMD_TYPE_GET"
+#endif
+#if CMD_COALESCE && !(CMD_STATEMENT || CMD_PRIORITY)
+    #error "CMD_COALESCE need CMD_STATEMENT or CMD_PRIORITY for batch of statements"
+#endif
+#if CMD_BOUNDED && !CMD_SORT_LIST
+    #error "CMD_BOUNDED need CMD_SORT_LIST for binary search"
+#endif
 #if CMD_CASE_MODE == CMD_CASE_INSENSITIVE
     #if CMD_NAME_MODE == CMD_LOWER_CASE
         #define __convert(STR, LEN) Str_lowerCaseFix((STR), (LEN))
@@ -58,6 +67,17 @@ const Cmd_Str CMD_END_WITH = CMD_STR_INIT(CMD_DEFAULT_END_WITH);
 #else
     #define __convert(STR, LEN)
 #endif
+#if CMD_STATEMENT
+    #define __stopOnError(MANAGER)      ((MANAGER)->StopOnError)
+#else
+    #define __stopOnError(MANAGER)      0
+#endif
+#if CMD_MULTILINE
+    #define __mayContinue(HEAD)         (((HEAD)->Options & Cmd_Option_Multiline) != 0)
+#else
+    // without marks any command may return Cmd_Continue
+    #define __mayContinue(HEAD)         1
+#endif
 #if CMD_LIST_MODE == CMD_LIST_ARRAY
     #define __castCmd(VAL)      Mem_castItem(Cmd, VAL)
 #else
@@ -66,6 +86,89 @@ const Cmd_Str CMD_END_WITH = CMD_STR_INIT(CMD_DEFAULT_END_WITH);
 #define __castStr(VAL)          Mem_castItem(Cmd_Str, VAL)
 #define __castStrPtr(VAL)       (*Mem_castItem(Cmd_Str*, VAL))
 #define __max(A, B)             ((A) > (B) ? (A) : (B))
+#define __min(A, B)             ((A) < (B) ? (A) : (B))
+#if CMD_RCU
+    #define __enter(MANAGER)                    if ((MANAGER)->Registry != NULL) { \
+                                                    CmdRegistry_enter((MANAGER)->Registry, (MANAGER)); \
+                                                }
+    #define __leave(MANAGER)                    if ((MANAGER)->Registry != NULL) { \
+                                                    CmdRegistry_leave((MANAGER)->Registry, (MANAGER)); \
+                                                }
+#else
+    #define __enter(MANAGER)
+    #define __leave(MANAGER)
+#endif // CMD_RCU
+#if CMD_CAPTURE
+    #define __capture(MANAGER, DATA, LEN)       if ((MANAGER)->capture) { \
+                                                    (MANAGER)->capture((MANAGER), (MANAGER)->CaptureArgs, (DATA), (LEN)); \
+                                                }
+#else
+    #define __capture(MANAGER, DATA, LEN)
+#endif // CMD_CAPTURE
+#if CMD_TABLE
+    #if CMD_MULTI_CALLBACK
+        #define __CALLBACKS_LEN     (CMD_TYPE_LEN + CMD_TYPE_UNKNOWN)
+    #else
+        #define __CALLBACKS_LEN     1
+    #endif // CMD_MULTI_CALLBACK
+    /* Keys, NameLens, Types, CallbackMasks and Options */
+    #define __TABLE_BYTES           (4 + (CMD_OPTIONS != 0))
+#endif // CMD_TABLE
+/* private types */
+/**
+ * @brief result of parse cmd name and type
+ */
+typedef enum {
+    Cmd_HeadResult_None,            /**< not parsed yet */
+    Cmd_HeadResult_Found,
+    Cmd_HeadResult_NotFound,
+    Cmd_HeadResult_Ignore,          /**< StartWith not match */
+} Cmd_HeadResult;
+/**
+ * @brief hold resolved cmd and type of a line
+ */
+typedef struct {
+    Cmd*            Cmd;            /**< can be NULL for Cmd_Table without Cmds */
+    Cmd_CallbackFn  Fn;             /**< NULL if cmd not support type */
+    char*           Params;
+    Str_LenType     Len;
+    Mem_LenType     Index;          /**< index of cmd in list or table */
+    Mem_LenType     TypeIndex;      /**< -1 for unknown type */
+    uint8_t         CallbackIndex;  /**< type index of Fn */
+#if CMD_OPTIONS
+    uint8_t         Options;
+#endif
+} Cmd_Head;
+/**
+ * @brief hold single command of a line
+ */
+typedef struct {
+    char*           Ptr;
+    Str_LenType     Len;
+    Cmd_HeadResult  Result;
+    Cmd_Head        Head;
+#if CMD_PRIORITY
+    uint8_t         Dispatched;
+#endif
+} Cmd_Statement;
+/**
+ * @brief result of process a command, same values of Cmd_AuditResult
+ */
+typedef enum {
+    Cmd_Result_Done,
+    Cmd_Result_NotFound,
+    Cmd_Result_Error,
+#if CMD_RATE_LIMIT
+    Cmd_Result_Shed,
+#endif
+} Cmd_Result;
+#if CMD_CHUNK
+typedef enum {
+    Cmd_ChunkState_Idle,
+    Cmd_ChunkState_Stream,          /**< pass chunks to ChunkFn */
+    Cmd_ChunkState_Drop,            /**< ignore chunks until EndWith */
+} Cmd_ChunkState;
+#endif // CMD_CHUNK
 /* private functions */
 #if CMD_SORT_LIST
     static Mem_CmpResult Cmd_compare(const void* itemA, const void* itemB, Mem_LenType itemLen);
@@ -73,6 +176,71 @@ const Cmd_Str CMD_END_WITH = CMD_STR_INIT(CMD_DEFAULT_END_WITH);
 #endif // CMD_SORT_LIST
 static Mem_CmpResult Cmd_compareName(const void* name, const void* cmd, Mem_LenType itemLen);
 static Mem_CmpResult CmdType_compare(const void* name, const void* type, Mem_LenType itemLen);
+static Cmd_CallbackFn Cmd_getCallback(Cmd* cmd, uint8_t typeIndex);
+static Cmd_HeadResult CmdManager_parseHead(CmdManager* manager, char* buffer, Str_LenType lineLen, Cmd_Head* head);
+static Mem_LenType CmdManager_findName(CmdManager* manager, Cmd_Str* name);
+#if CMD_RATE_LIMIT || CMD_CACHE
+    static Mem_LenType CmdManager_findCmd(CmdManager* manager, const char* name, const void** key);
+    static const void* CmdManager_key(CmdManager* manager, Mem_LenType index);
+#endif
+#if CMD_CHAR_CLASS
+    static Cmd_HeadResult CmdManager_tokenizeHead(CmdManager* manager, char* buffer, Str_LenType lineLen, Cmd_Head* head);
+    static Cmd_HeadResult CmdManager_tokenizeName(CmdManager* manager, char* buffer, Cmd_Str* cmdStr, Cmd_Str* typeStr);
+#endif
+static void CmdManager_resolveHead(CmdManager* manager, Cmd_Head* head);
+static Cmd_Result CmdManager_dispatch(CmdManager* manager, Cmd_Head* head, Param_Cursor* cursor);
+static Cmd_Result CmdManager_processStatement(CmdManager* manager, Cmd_Statement* statement, Param_Cursor* cursor);
+#if CMD_PRIORITY
+    static void CmdManager_processBatch(CmdManager* manager, Cmd_Statement* statements, Mem_LenType len, Param_Cursor* cursor);
+    static void CmdManager_runPriority(CmdManager* manager, IStream* stream, char* buffer, Str_LenType len, Param_Cursor* cursor);
+    static int8_t CmdManager_classifyLine(CmdManager* manager, char* buffer, Str_LenType lineLen);
+    static uint8_t CmdManager_drainLine(CmdManager* manager, Stream_LenType len);
+#endif
+#if CMD_STATEMENT
+    static void CmdManager_processStatements(CmdManager* manager, char* buffer, Str_LenType lineLen, Param_Cursor* cursor);
+    static void CmdManager_joinStatements(CmdManager* manager, Cmd_Statement* statement, char* end, Param_Cursor* cursor);
+#endif
+#if CMD_STATEMENT || CMD_PRIORITY
+    static Mem_LenType CmdManager_splitStatements(CmdManager* manager, char** buffer, char* end, Cmd_Statement* statements, Mem_LenType len);
+#endif
+#if CMD_COALESCE
+    static uint8_t CmdManager_isSuperseded(CmdManager* manager, Cmd_Statement* statements, Mem_LenType index, Mem_LenType len);
+    static void CmdManager_resolveStatement(CmdManager* manager, Cmd_Statement* statement);
+    static Mem_CmpResult CmdManager_compareKey(CmdManager* manager, Cmd_Head* a, Cmd_Head* b);
+    static Str_LenType CmdManager_keyLen(CmdManager* manager, Cmd_Head* head);
+#endif
+#if CMD_CHUNK
+    static void CmdManager_handleChunk(CmdManager* manager, IStream* stream, char* buffer, Str_LenType len, Param_Cursor* cursor);
+#endif
+#if CMD_TABLE
+    static void CmdTable_count(Cmd_Array* cmds, Cmd_LenType len, uint32_t* callbacks, uint32_t* names);
+    static Mem_CmpResult CmdTable_compare(const Cmd_Table* table, uint16_t index, uint8_t key, const char* name, uint8_t len);
+#endif
+#if CMD_AUDIT
+    static void CmdManager_audit(CmdManager* manager, const char* line, Str_LenType len, Cmd_Head* head, Cmd_Result result);
+#endif
+#if CMD_RATE_LIMIT
+    static uint8_t CmdLimit_take(Cmd_Limit* limit, uint32_t ticks);
+    static uint8_t CmdManager_admit(CmdManager* manager, Cmd_Limit* limit, Cmd* cmd, char* str);
+    static Cmd_Limit* CmdManager_limit(CmdManager* manager, Mem_LenType index, const void* key);
+#endif
+#if CMD_CACHE
+    static Cmd_CacheEntry* CmdManager_cacheEntry(CmdManager* manager, Mem_LenType index, const void* key);
+#endif
+#if CMD_PREPARED
+    static Cmd_Handled CmdManager_run(CmdManager* manager, Cmd_Prepared* prepared, Param_Cursor* cursor);
+#endif
+#if CMD_INDEX
+    static Mem_CmpResult CmdIndex_compare(Cmd* a, Cmd* b);
+    static char CmdIndex_convert(char c);
+    static uint16_t CmdIndex_find(Cmd_Index* index, uint16_t node, char c);
+    static Cmd_LenType CmdIndex_insert(Cmd_Suggestion* result, Cmd_LenType len, Cmd_LenType max, Cmd* cmd, uint8_t distance);
+    static void CmdIndex_source(CmdManager* manager, Cmd_List* list);
+    static uint8_t CmdIndex_check(CmdManager* manager);
+    static uint8_t CmdIndex_build(CmdManager* manager);
+    static Cmd_LenType CmdIndex_complete(Cmd_Index* index, const char* prefix, Str_LenType len, Cmd** result, Cmd_LenType max);
+    static Cmd_LenType CmdIndex_suggest(Cmd_Index* index, const char* name, Str_LenType len, uint8_t maxDistance, Cmd_Suggestion* result, Cmd_LenType max);
+#endif
 /**
  * @brief initialize Cmd
  *
@@ -84,6 +252,9 @@ void Cmd_init(Cmd* cmd, const char* name, Cmd_Type types) {
     cmd->CmdName.Text = name;
     cmd->CmdName.Len = Str_len(name);
     cmd->Types.Flags = (uint8_t) types;
+#if CMD_OPTIONS
+    cmd->Options.Flags = 0;
+#endif
     Mem_set(cmd->Callbacks.fn, 0x00, sizeof(Cmd_Callbacks));
 }
 /**
@@ -95,6 +266,17 @@ void Cmd_init(Cmd* cmd, const char* name, Cmd_Type types) {
 void Cmd_setTypes(Cmd* cmd, Cmd_Type types) {
     cmd->Types.Flags = (uint8_t) types;
 }
+#if CMD_OPTIONS
+/**
+ * @brief set options of cmd
+ *
+ * @param cmd
+ * @param options
+ */
+void Cmd_setOptions(Cmd* cmd, Cmd_Option options) {
+    cmd->Options.Flags = (uint8_t) options;
+}
+#endif // CMD_OPTIONS
 #if CMD_MULTI_CALLBACK
 #if CMD_TYPE_EXE
 void Cmd_onExecute(Cmd* cmd, Cmd_CallbackFn fn) {
@@ -147,12 +329,79 @@ void CmdManager_init(CmdManager* manager, Cmd_Array* cmds, Cmd_LenType len) {
     manager->List.Len = len;
     manager->notFound = (Cmd_NotFoundFn) NULL;
     manager->bufferOverflow = (Cmd_OverflowFn) NULL;
+#if CMD_CAPTURE
+    manager->capture = (Cmd_CaptureFn) NULL;
+    manager->CaptureArgs = NULL;
+#endif
+#if CMD_AUDIT
+    manager->audit = (Cmd_AuditFn) NULL;
+    manager->AuditArgs = NULL;
+#endif
+#if CMD_RATE_LIMIT
+    manager->overload = (Cmd_OverloadFn) NULL;
+    manager->Limits = NULL;
+    manager->LimitsLen = 0;
+    CmdLimit_init(&manager->Limit, 0, 0);
+#endif
+#if CMD_CACHE
+    manager->respond = (Cmd_RespondFn) NULL;
+    manager->Cache = NULL;
+    manager->CacheLen = 0;
+    manager->Recording = NULL;
+#endif
+#if CMD_TICKS
+    manager->Ticks = 0;
+#endif
     manager->ParamSeparator = CMD_DEFAULT_PARAM_SEPARATOR;
-    manager->InUseCmd = NULL;
+    CmdManager_resetInput(manager);
+#if CMD_TABLE
+    manager->Table = NULL;
+#endif
+#if CMD_INDEX
+    manager->Index.Nodes = NULL;
+    manager->Index.List.Cmds = NULL;
+    manager->Index.List.Len = 0;
+    manager->Index.Len = 0;
+#endif
+#if CMD_CHAR_CLASS
+    manager->CharClass = NULL;
+#endif
+#if CMD_RCU
+    manager->Registry = NULL;
+    manager->Pins = 0;
+    manager->Slot = 0;
+#endif
+#if CMD_STATEMENT
+    manager->StatementSeparator = CMD_DEFAULT_STATEMENT_SEPARATOR;
+    manager->StopOnError = 0;
+#endif
+#if CMD_STATS
+    CmdManager_resetStats(manager);
+#endif
 #if CMD_SORT_LIST
     __sort(manager->List.Cmds, manager->List.Len, sizeof(manager->List.Cmds[0]), Cmd_compare, Cmd_swap);
 #endif
 }
+/**
+ * @brief reset state of current input, in use multiline command, chunk stream and priority scan,
+ * copies of a manager must start with it
+ *
+ * @param manager
+ */
+void CmdManager_resetInput(CmdManager* manager) {
+    manager->InUseCmd = NULL;
+    manager->InUseFn = (Cmd_CallbackFn) NULL;
+#if CMD_CHUNK
+    manager->ChunkCmd = NULL;
+    manager->ChunkFn = (Cmd_CallbackFn) NULL;
+    manager->ChunkState = Cmd_ChunkState_Idle;
+    manager->Chunk = Cmd_Chunk_Whole;
+#endif
+#if CMD_PRIORITY
+    manager->SkipsLen = 0;
+    manager->Scanned = 0;
+#endif
+}
 /**
  * @brief set pattern for start of commands
  *
@@ -189,286 +438,2633 @@ void CmdManager_onNotFound(CmdManager* manager, Cmd_NotFoundFn notFound) {
 void CmdManager_onOverflow(CmdManager* manager, Cmd_OverflowFn overflow) {
     manager->bufferOverflow = overflow;
 }
+#if CMD_CAPTURE
 /**
- * @brief set param separator
+ * @brief set capture callback, it's call with raw bytes of each read from input,
+ * include EndWith, concatenation of all captured data is same as input
  *
  * @param manager
- * @param sep
+ * @param capture
+ * @param args pass to capture callback
  */
-void CmdManager_setParamSeparator(CmdManager* manager, char sep) {
-    manager->ParamSeparator = sep;
+void CmdManager_onCapture(CmdManager* manager, Cmd_CaptureFn capture, void* args) {
+    manager->capture = capture;
+    manager->CaptureArgs = args;
 }
 /**
- * @brief set commands list
+ * @brief pass line that not read from stream to capture callback, ex: lines of CmdQueue or CmdIpc,
+ * EndWith captured with line in same record, so replay see same input as stream,
+ * lines longer than CMD_CAPTURE_LINE_MAX capture EndWith in next record
  *
  * @param manager
- * @param cmds
+ * @param line without EndWith
  * @param len
  */
-void CmdManager_setCommands(CmdManager* manager, Cmd_Array* cmds, Cmd_LenType len) {
-    manager->List.Cmds = cmds;
-    manager->List.Len = len;
-#if CMD_SORT_LIST
-    __sort(manager->List.Cmds, manager->List.Len, sizeof(manager->List.Cmds[0]), Cmd_compare, Cmd_swap);
-#endif
+void CmdManager_captureLine(CmdManager* manager, const char* line, Str_LenType len) {
+    char record[CMD_CAPTURE_LINE_MAX];
+    Str_LenType endLen;
+
+    if (manager->capture) {
+        endLen = manager->EndWith->Len;
+        if ((uint32_t) len + endLen <= CMD_CAPTURE_LINE_MAX) {
+            Mem_copy(record, line, len);
+            Mem_copy(&record[len], manager->EndWith->Text, endLen);
+            manager->capture(manager, manager->CaptureArgs, record, len + endLen);
+        }
+        else {
+            manager->capture(manager, manager->CaptureArgs, line, len);
+            manager->capture(manager, manager->CaptureArgs, manager->EndWith->Text, endLen);
+        }
+    }
 }
+#endif // CMD_CAPTURE
+#if CMD_AUDIT
 /**
- * @brief set pattern types
+ * @brief set audit callback, call after each command with it's result,
+ * lines of in use multi line command not audit, command audit once
  *
  * @param manager
- * @param patterns
+ * @param audit
+ * @param args pass to audit callback
  */
-void CmdManager_setPatternTypes(CmdManager* manager, Cmd_PatternTypes* patterns) {
-    manager->PatternTypes = patterns;
+void CmdManager_onAudit(CmdManager* manager, Cmd_AuditFn audit, void* args) {
+    manager->audit = audit;
+    manager->AuditArgs = args;
 }
-#if CMD_MANAGER_ARGS
+#endif // CMD_AUDIT
+#if CMD_RATE_LIMIT
 /**
- * @brief set args for manager
+ * @brief initialize token bucket with full tokens
+ *
+ * @param limit
+ * @param burst max tokens, 0 for no limit
+ * @param period ticks per token
+ */
+void CmdLimit_init(Cmd_Limit* limit, uint16_t burst, uint16_t period) {
+    limit->Last = 0;
+    limit->Shed = 0;
+    limit->Tokens = burst;
+    limit->Burst = burst;
+    limit->Period = period;
+}
+/**
+ * @brief set overload callback, call when a line or command shed
  *
  * @param manager
- * @param args
+ * @param overload
  */
-void CmdManager_setArgs(CmdManager* manager, void* args) {
-    manager->Args = args;
+void CmdManager_onOverload(CmdManager* manager, Cmd_OverloadFn overload) {
+    manager->overload = overload;
 }
 /**
- * @brief get args for manager
+ * @brief set limit of lines, checked before lookup,
+ * lines of in use multi line command not limited
  *
  * @param manager
- * @return void*
+ * @param burst max lines without wait, 0 for no limit
+ * @param period ticks per line
  */
-void* CmdManager_getArgs(CmdManager* manager) {
-    return manager->Args;
+void CmdManager_setLimit(CmdManager* manager, uint16_t burst, uint16_t period) {
+    CmdLimit_init(&manager->Limit, burst, period);
+    manager->Limit.Last = manager->Ticks;
 }
-#endif
-#if CMD_STREAM
 /**
- * @brief process incoming messages
+ * @brief set limits of commands, checked after lookup before callback,
+ * limits keep command that set them, after commands change limit of moved command skip until set again
  *
  * @param manager
- * @param stream
+ * @param limits array in order of list (after sort) or table, all entries must init with zero, NULL for disable
+ * @param len length of limits, commands after it have no limit
  */
-void CmdManager_handle(CmdManager* manager, IStream* stream) {
-    Param_Cursor cursor;
-    char buffer[CMD_HANDLE_BUFFER_SIZE];
-
-    CmdManager_handleStatic(manager, stream, buffer, sizeof(buffer), &cursor);
+void CmdManager_setLimits(CmdManager* manager, Cmd_Limit* limits, Cmd_LenType len) {
+    manager->Limits = limits;
+    manager->LimitsLen = len;
 }
 /**
- * @brief process incoming messages with static buffer and cursor for memory safety
+ * @brief set limit of a command, limits array must set before
  *
  * @param manager
- * @param stream
- * @param buffer
- * @param len
- * @param cursor
+ * @param name name of command
+ * @param burst max commands without wait, 0 for no limit
+ * @param period ticks per command
+ * @return uint8_t 1 if command found
  */
-void CmdManager_handleStatic(CmdManager* manager, IStream* stream, char* buffer, Str_LenType len, Param_Cursor* cursor) {
-    if (IStream_available(stream) > 0) {
-        Stream_LenType lineLen = IStream_readBytesUntilPattern(stream, (const uint8_t*) manager->EndWith->Text, manager->EndWith->Len, (uint8_t*) buffer, len);
-        if (lineLen > 0) {
-            lineLen -= manager->EndWith->Len;
-            // check end with for overflow error
-            if (Str_compareFix((const char*) &buffer[lineLen], (const char*) manager->EndWith->Text, manager->EndWith->Len) != 0) {
-                if (manager->bufferOverflow) {
-                    manager->bufferOverflow(manager);
-                }
-                return;
-            }
-            // remove endWith
-            buffer[lineLen] = '\0';
-            // check it's empty line or not
-            if(lineLen == 0) {
-                return;
-            }
-            CmdManager_processLine(manager, buffer, lineLen, cursor);
-        }
+uint8_t CmdManager_setCmdLimit(CmdManager* manager, const char* name, uint16_t burst, uint16_t period) {
+    Mem_LenType index;
+    const void* key;
+
+    if (manager->Limits == NULL) {
+        return 0;
     }
+    index = CmdManager_findCmd(manager, name, &key);
+    if (index == -1 || index >= (Mem_LenType) manager->LimitsLen) {
+        return 0;
+    }
+    CmdLimit_init(&manager->Limits[index], burst, period);
+    manager->Limits[index].Key = key;
+    manager->Limits[index].Last = manager->Ticks;
+    return 1;
 }
-#endif // CMD_STREAM
+#endif // CMD_RATE_LIMIT
+#if CMD_CACHE
 /**
- * @brief process string buffer
+ * @brief set respond callback, CmdManager_respond pass responses to it
  *
  * @param manager
- * @param buffer
- * @param lineLen
- * @param cursor
+ * @param respond
  */
-char* CmdManager_process(CmdManager* manager, char* buffer, Str_LenType len, Param_Cursor* cursor) {
-    if (len > 0) {
-        // read line
-        Str_LenType lineLen = Str_posOf(buffer, *manager->EndWith->Text);
-        if (lineLen > 0) {
-            // check end with for overflow error
-            if (Str_compareFix((const char*) &buffer[lineLen], (const char*) manager->EndWith->Text, manager->EndWith->Len) != 0) {
-                if (manager->bufferOverflow) {
-                    manager->bufferOverflow(manager);
-                }
-                return NULL;
-            }
-            // remove endWith
-            buffer[lineLen] = '\0';
-            // check it's empty line or not
-            if(lineLen == 0) {
-                return NULL;
-            }
-            // process line
-            CmdManager_processLine(manager, buffer, lineLen, cursor);
-            // return end of line
-            return &buffer[lineLen + manager->EndWith->Len];
-        }
-    }
-    return NULL;
+void CmdManager_onRespond(CmdManager* manager, Cmd_RespondFn respond) {
+    manager->respond = respond;
 }
 /**
- * @brief process single line without check ending pattern
+ * @brief write response of current command, callbacks must use it for cacheable responses
+ * response of Get that not fit in cache entry don't cache
  *
  * @param manager
- * @param buffer
+ * @param data
  * @param len
- * @param cursor
  */
-void CmdManager_processLine(CmdManager* manager, char* buffer, Str_LenType lineLen, Param_Cursor* cursor) {
-    Cmd_Str cmdStr;
-    Mem_LenType cmdIndex;
-    char* baseBuffer = buffer;
-#if CMD_REMOVE_BACKSPACE
-    // remove backspaces
-    Str_removeBackspaceFix(buffer, lineLen);
-#endif // CMD_REMOVE_BACKSPACE
-    // check it's from last cmd or it's new cmd
-    if (manager->InUseCmd == NULL) {
-        // ignore whitspaces in start of frame
-        buffer = Str_ignoreWhitespace(buffer);
-        // check start with
-        if (manager->StartWith) {
-        #if CMD_CONVERT_START_WITH
-            __convert(buffer, manager->StartWith->Len);
-        #endif // CMD_CONVERT_START_WITH
-            if (Str_compareFix(buffer, manager->StartWith->Text, manager->StartWith->Len) == 0) {
-                buffer += manager->StartWith->Len;
-                // ignore whitspaces
-                buffer = Str_ignoreWhitespace(buffer);
-            }
-            else {
-                return;
-            }
-        }
-        // find cmd name len
-        cmdStr.Text = buffer;
-        buffer = Str_ignoreNameCharacters(buffer);
-        cmdStr.Len = (Str_LenType) (buffer - cmdStr.Text);
-        lineLen -= cmdStr.Len;
-        // find cmd
-        __convert((char*) cmdStr.Text, cmdStr.Len);
-        cmdIndex = __search(manager->List.Cmds, manager->List.Len, sizeof(manager->List.Cmds[0]), &cmdStr, Cmd_compareName);
-        if (cmdIndex != -1) {
-            Cmd* cmd = CmdList_get(manager->List.Cmds, cmdIndex);
-            if (manager->PatternTypes) {
-                Cmd_Type type = Cmd_Type_None;
-                Mem_LenType typeIndex;
-                // ignore whitespaces between Cmd_Name and Cmd_Type
-                buffer = Str_ignoreWhitespace(buffer);
-                // find cmd type len
-                cmdStr.Text = buffer;
-                buffer = Str_ignoreCommandCharacters(buffer);
-                cmdStr.Len = (Str_LenType) (buffer - cmdStr.Text);
-                lineLen -= cmdStr.Len;
-                // find cmd type
-                typeIndex = Mem_linearSearch(manager->PatternTypes->Patterns, CMD_TYPE_LEN, sizeof(Cmd_Str*), &cmdStr, CmdType_compare);
-                if (typeIndex != -1) {
-                    cursor->Ptr = buffer;
-                    cursor->Len = lineLen;
-                    cursor->ParamSeparator = manager->ParamSeparator;
-                    cursor->Index = 0;
-                    type = (Cmd_Type) (1 << typeIndex);
-                #if CMD_MULTI_CALLBACK
-                    if (cmd->Callbacks.fn[typeIndex] && (cmd->Types.Flags & type)) {
-                        if (cmd->Callbacks.fn[typeIndex](manager, cmd, cursor, type) != Cmd_Done) {
-                            manager->InUseCmd = cmd;
-                            manager->InUseCmdTypeIndex = typeIndex;
-                        }
-                        return;
-                    }
-                #else
-                    if (cmd->Callbacks.fn[0] && (cmd->Types.Flags & type)) {
-                        if (cmd->Callbacks.fn[0](cmd, cursor, type) != Cmd_Done) {
-                            manager->InUseCmd = cmd;
-                            manager->InUseCmdTypeIndex = typeIndex;
-                        }
-                        return;
-                    }
-                #endif // CMD_MULTI_CALLBACK
-                }
-                else {
-                #if CMD_TYPE_UNKNOWN
-                #if CMD_MULTI_CALLBACK
-                    if (cmd->Callbacks.unknown && (cmd->Types.Flags & Cmd_Type_Unknown)) {
-                        if (cmd->Callbacks.unknown(manager, cmd, cursor, type) != Cmd_Done) {
-                            manager->InUseCmd = cmd;
-                            manager->InUseCmdTypeIndex = typeIndex;
-                        }
-                        return;
-                    }
-                #else
-                    if (cmd->Callbacks.fn[0] && (cmd->Types.Flags & Cmd_Type_Unknown)) {
-                        if (cmd->Callbacks.fn[0](cmd, cursor, type) != Cmd_Done) {
-                            manager->InUseCmd = cmd;
-                            manager->InUseCmdTypeIndex = typeIndex;
-                        }
-                        return;
-                    }
-                #endif // CMD_MULTI_CALLBACK
-                #endif // CMD_TYPE_UNKNOWN
-                }
-            }
+void CmdManager_respond(CmdManager* manager, const char* data, Str_LenType len) {
+    Cmd_CacheEntry* entry = manager->Recording;
+
+    if (entry) {
+        if (len <= entry->Size - entry->Len) {
+            Mem_copy(&entry->Buffer[entry->Len], data, len);
+            entry->Len += len;
         }
-        // run not found
-        if (manager->notFound) {
-            manager->notFound(manager, baseBuffer);
+        else {
+            manager->Recording = NULL;
         }
     }
-    else {
-        cursor->Ptr = buffer;
-        cursor->Len = lineLen;
-        cursor->ParamSeparator = manager->ParamSeparator;
-        cursor->Index = 0;
-    #if CMD_MULTI_CALLBACK
-        if (manager->InUseCmd->Callbacks.fn[manager->InUseCmdTypeIndex](manager, manager->InUseCmd, cursor, (Cmd_Type) (1 << manager->InUseCmdTypeIndex)) == Cmd_Done) {
-            manager->InUseCmd = NULL;
-        }
-    #else
-        if (manager->InUseCmd->Callbacks.fn[0](manager, manager->InUseCmd, cursor, (Cmd_Type) (1 << manager->InUseCmdTypeIndex)) == Cmd_Done) {
-            manager->InUseCmd = NULL;
-        }
-    #endif // CMD_MULTI_CALLBACK
+    if (manager->respond) {
+        manager->respond(manager, data, len);
     }
 }
-static Mem_CmpResult Cmd_compareName(const void* name, const void* cmd, Mem_LenType itemLen) {
-    Mem_LenType len = __max(__castStr(name)->Len, __castCmd(cmd)->CmdName.Len);
+/**
+ * @brief set cache entries of commands, all entries must init with zero or CmdManager_setCmdCache
+ * entries keep command that set them, after commands change entry of moved command skip until set again
+ *
+ * @param manager
+ * @param cache array in order of list (after sort) or table, NULL for disable
+ * @param len length of cache, commands after it have no cache
+ */
+void CmdManager_setCache(CmdManager* manager, Cmd_CacheEntry* cache, Cmd_LenType len) {
+    manager->Cache = cache;
+    manager->CacheLen = len;
+}
+/**
+ * @brief enable cache for a command, cache entries must set before
+ *
+ * @param manager
+ * @param name name of command
+ * @param buffer buffer of response
+ * @param size size of buffer
+ * @param ttl ticks that response is valid, 0 for disable
+ * @return uint8_t 1 if command found
+ */
+uint8_t CmdManager_setCmdCache(CmdManager* manager, const char* name, char* buffer, Str_LenType size, uint16_t ttl) {
+    Cmd_CacheEntry* entry;
+    Mem_LenType index;
+    const void* key;
 
-    return Mem_compare(__castStr(name)->Text, __castCmd(cmd)->CmdName.Text, len);
+    if (manager->Cache == NULL) {
+        return 0;
+    }
+    index = CmdManager_findCmd(manager, name, &key);
+    if (index == -1 || index >= (Mem_LenType) manager->CacheLen) {
+        return 0;
+    }
+    entry = &manager->Cache[index];
+    entry->Key = key;
+    entry->Buffer = buffer;
+    entry->Size = size;
+    entry->Len = 0;
+    entry->TTL = ttl;
+    entry->Valid = 0;
+    return 1;
 }
-static Mem_CmpResult CmdType_compare(const void* name, const void* type, Mem_LenType itemLen) {
-    Mem_LenType len = __max(__castStr(name)->Len, __castStrPtr(type)->Len);
+/**
+ * @brief invalidate cached response of a command, next Get call callback
+ *
+ * @param manager
+ * @param name name of command
+ * @return uint8_t 1 if command has cache entry
+ */
+uint8_t CmdManager_invalidate(CmdManager* manager, const char* name) {
+    Cmd_CacheEntry* entry;
+    Mem_LenType index;
+    const void* key;
 
-    return Mem_compare(__castStr(name)->Text, __castStrPtr(type)->Text, len);
+    if (manager->Cache == NULL) {
+        return 0;
+    }
+    index = CmdManager_findCmd(manager, name, &key);
+    if (index == -1) {
+        return 0;
+    }
+    entry = CmdManager_cacheEntry(manager, index, key);
+    if (entry == NULL) {
+        return 0;
+    }
+    entry->Valid = 0;
+    return 1;
 }
-#if CMD_SORT_LIST
-static void Cmd_swap(void* itemA, void* itemB, Mem_LenType itemLen) {
-#if CMD_LIST_MODE == CMD_LIST_ARRAY
-    Cmd temp;
-    Mem_copy((uint8_t*) &temp, itemA, itemLen);
-    Mem_copy(itemA, itemB, itemLen);
-    Mem_copy(itemB, (uint8_t*) &temp, itemLen);
-#else
-    Cmd* temp;
-    Mem_copy(&temp, itemA, itemLen);
-    Mem_copy(itemA, itemB, itemLen);
-    Mem_copy(itemB, &temp, itemLen);
-#endif // CMD_LIST_MODE
+/**
+ * @brief invalidate cached responses of all commands
+ *
+ * @param manager
+ */
+void CmdManager_invalidateAll(CmdManager* manager) {
+    Mem_LenType index;
+
+    if (manager->Cache == NULL) {
+        return;
+    }
+    for (index = 0; index < (Mem_LenType) manager->CacheLen; index++) {
+        manager->Cache[index].Valid = 0;
+    }
 }
-static Mem_CmpResult Cmd_compare(const void* itemA, const void* itemB, Mem_LenType itemLen) {
-    return Str_compare(__castCmd(itemA)->CmdName.Text, __castCmd(itemB)->CmdName.Text);
+/**
+ * @brief return cache entry of command if it set for same command
+ *
+ * @param manager
+ * @param index index of command
+ * @param key key of command
+ * @return Cmd_CacheEntry* NULL if cache disabled, index out of cache or entry belong to other command
+ */
+static Cmd_CacheEntry* CmdManager_cacheEntry(CmdManager* manager, Mem_LenType index, const void* key) {
+    Cmd_CacheEntry* entry;
+
+    if (manager->Cache == NULL || index >= (Mem_LenType) manager->CacheLen) {
+        return NULL;
+    }
+    entry = &manager->Cache[index];
+    return entry->Key == key ? entry : NULL;
 }
-#endif // CMD_SORT_LIST
+#endif // CMD_CACHE
+#if CMD_TICKS
+/**
+ * @brief advance time of limits and cache, can call from timer
+ *
+ * @param manager
+ * @param ticks elapsed ticks
+ */
+void CmdManager_tick(CmdManager* manager, uint32_t ticks) {
+    manager->Ticks += ticks;
+}
+#endif // CMD_TICKS
+/**
+ * @brief set param separator
+ *
+ * @param manager
+ * @param sep
+ */
+void CmdManager_setParamSeparator(CmdManager* manager, char sep) {
+    manager->ParamSeparator = sep;
+}
+#if CMD_STATEMENT
+/**
+ * @brief set statement separator, '\0' means single command per line
+ *
+ * @param manager
+ * @param sep
+ */
+void CmdManager_setStatementSeparator(CmdManager* manager, char sep) {
+    manager->StatementSeparator = sep;
+}
+/**
+ * @brief stop process rest of line on first not found or Cmd_Error statement
+ *
+ * @param manager
+ * @param enabled
+ */
+void CmdManager_setStopOnError(CmdManager* manager, uint8_t enabled) {
+    manager->StopOnError = enabled;
+}
+#endif // CMD_STATEMENT
+/**
+ * @brief set commands list
+ *
+ * @param manager
+ * @param cmds
+ * @param len
+ */
+void CmdManager_setCommands(CmdManager* manager, Cmd_Array* cmds, Cmd_LenType len) {
+    manager->List.Cmds = cmds;
+    manager->List.Len = len;
+#if CMD_SORT_LIST
+    __sort(manager->List.Cmds, manager->List.Len, sizeof(manager->List.Cmds[0]), Cmd_compare, Cmd_swap);
+#endif
+#if CMD_INDEX
+    CmdManager_buildIndex(manager);
+#endif
+}
+#if CMD_RCU
+/**
+ * @brief initialize registry with first version of commands
+ *
+ * @param registry
+ * @param cmds
+ * @param len
+ */
+void CmdRegistry_init(Cmd_Registry* registry, Cmd_Array* cmds, Cmd_LenType len) {
+    Mem_set(registry, 0, sizeof(Cmd_Registry));
+#if CMD_SORT_LIST
+    __sort(cmds, len, sizeof(cmds[0]), Cmd_compare, Cmd_swap);
+#endif
+    registry->Slots[0].List.Cmds = cmds;
+    registry->Slots[0].List.Len = len;
+}
+/**
+ * @brief publish new version of commands, cmds must not change after publish,
+ * wait until readers of version before current leave it, only one thread can publish
+ * previous cmds can reclaim after CmdRegistry_synchronize
+ *
+ * @param registry
+ * @param cmds
+ * @param len
+ */
+void CmdRegistry_publish(Cmd_Registry* registry, Cmd_Array* cmds, Cmd_LenType len) {
+    uint32_t version = __atomic_load_n(&registry->Version, __ATOMIC_RELAXED);
+    Cmd_RegistrySlot* slot = &registry->Slots[(version + 1) & 1];
+
+    // new version not visible yet, sort is safe
+#if CMD_SORT_LIST
+    __sort(cmds, len, sizeof(cmds[0]), Cmd_compare, Cmd_swap);
+#endif
+    CmdRegistry_synchronize(registry);
+    slot->List.Cmds = cmds;
+    slot->List.Len = len;
+#if CMD_TABLE
+    slot->Table = NULL;
+#endif
+    slot->Version = version + 1;
+    __atomic_store_n(&registry->Version, version + 1, __ATOMIC_SEQ_CST);
+}
+#if CMD_TABLE
+/**
+ * @brief publish new version of commands as compiled table
+ *
+ * @param registry
+ * @param table
+ */
+void CmdRegistry_publishTable(Cmd_Registry* registry, const Cmd_Table* table) {
+    uint32_t version = __atomic_load_n(&registry->Version, __ATOMIC_RELAXED);
+    Cmd_RegistrySlot* slot = &registry->Slots[(version + 1) & 1];
+
+    CmdRegistry_synchronize(registry);
+    slot->List.Cmds = table->Cmds;
+    slot->List.Len = table->Cmds ? table->Len : 0;
+    slot->Table = table;
+    slot->Version = version + 1;
+    __atomic_store_n(&registry->Version, version + 1, __ATOMIC_SEQ_CST);
+}
+#endif // CMD_TABLE
+/**
+ * @brief wait until no reader pin previous version
+ *
+ * @param registry
+ */
+void CmdRegistry_synchronize(Cmd_Registry* registry) {
+    // readers only pin for one dispatch
+    while (!CmdRegistry_isQuiescent(registry)) {
+        CMD_RCU_YIELD();
+    }
+}
+/**
+ * @brief check previous version has no reader and can reclaim
+ *
+ * @param registry
+ * @return uint8_t
+ */
+uint8_t CmdRegistry_isQuiescent(Cmd_Registry* registry) {
+    uint32_t version = __atomic_load_n(&registry->Version, __ATOMIC_RELAXED);
+
+    return __atomic_load_n(&registry->Readers[(version + 1) & 1], __ATOMIC_SEQ_CST) == 0;
+}
+/**
+ * @brief return number of published versions
+ *
+ * @param registry
+ * @return uint32_t
+ */
+uint32_t CmdRegistry_version(Cmd_Registry* registry) {
+    return __atomic_load_n(&registry->Version, __ATOMIC_ACQUIRE);
+}
+/**
+ * @brief pin current version and set commands of manager from it,
+ * process functions call it for each dispatch, nested enter keep pinned version
+ *
+ * @param registry
+ * @param manager
+ * @return uint8_t pinned slot
+ */
+uint8_t CmdRegistry_enter(Cmd_Registry* registry, CmdManager* manager) {
+    uint32_t version;
+    uint8_t slot;
+
+    if (manager->Pins++ != 0) {
+        return manager->Slot;
+    }
+    for (;;) {
+        version = __atomic_load_n(&registry->Version, __ATOMIC_ACQUIRE);
+        slot = (uint8_t) (version & 1);
+        __atomic_add_fetch(&registry->Readers[slot], 1, __ATOMIC_SEQ_CST);
+        // slot can be reused by writer if version changed before pin
+        if (__atomic_load_n(&registry->Version, __ATOMIC_SEQ_CST) == version) {
+            break;
+        }
+        __atomic_sub_fetch(&registry->Readers[slot], 1, __ATOMIC_RELEASE);
+    }
+    // own commands restore on leave
+    manager->Own = manager->List;
+    manager->List = registry->Slots[slot].List;
+#if CMD_TABLE
+    manager->OwnTable = manager->Table;
+    manager->Table = registry->Slots[slot].Table;
+#endif
+    manager->Slot = slot;
+    return slot;
+}
+/**
+ * @brief unpin slot of manager on last leave and restore own commands of manager,
+ * so commands of version never used after unpin
+ *
+ * @param registry
+ * @param manager
+ */
+void CmdRegistry_leave(Cmd_Registry* registry, CmdManager* manager) {
+    if (--manager->Pins != 0) {
+        return;
+    }
+    manager->List = manager->Own;
+#if CMD_TABLE
+    manager->Table = manager->OwnTable;
+#endif
+    __atomic_sub_fetch(&registry->Readers[manager->Slot], 1, __ATOMIC_RELEASE);
+}
+/**
+ * @brief use shared registry for commands of manager, pass NULL to use own commands,
+ * Cmd objects that in use by multi line commands must live after reclaim of their version
+ *
+ * @param manager
+ * @param registry
+ */
+void CmdManager_setRegistry(CmdManager* manager, Cmd_Registry* registry) {
+    manager->Registry = registry;
+}
+#endif // CMD_RCU
+#if CMD_CHAR_CLASS
+/**
+ * @brief fill character class table with same classes of Str library and case mode,
+ * table can modify after init, ex: allow more characters in names
+ *
+ * @param charClass
+ */
+void CmdCharClass_init(Cmd_CharClass* charClass) {
+    char str[2];
+    uint16_t c;
+
+    charClass->Class[0] = Cmd_Char_None;
+    str[1] = '\0';
+    for (c = 1; c < 256; c++) {
+        uint8_t value = Cmd_Char_None;
+        str[0] = (char) c;
+        if (Str_ignoreWhitespace(str) != str) {
+            value |= Cmd_Char_Space;
+        }
+        if (Str_ignoreNameCharacters(str) != str) {
+            value |= Cmd_Char_Name;
+            __convert(str, 1);
+            if ((uint8_t) (str[0] ^ (char) c) == 0x20) {
+                value |= Cmd_Char_Fold;
+            }
+            str[0] = (char) c;
+        }
+        if (Str_ignoreCommandCharacters(str) != str) {
+            value |= Cmd_Char_Type;
+        }
+    #if CMD_REMOVE_BACKSPACE
+        if (c == '\b') {
+            value = Cmd_Char_Backspace;
+        }
+    #endif // CMD_REMOVE_BACKSPACE
+        charClass->Class[c] = value;
+    }
+}
+/**
+ * @brief set character class table of tokenizer, pass NULL to use Str functions
+ *
+ * @param manager
+ * @param charClass table must be valid while manager use it
+ */
+void CmdManager_setCharClass(CmdManager* manager, const Cmd_CharClass* charClass) {
+    manager->CharClass = charClass;
+}
+#endif // CMD_CHAR_CLASS
+#if CMD_TABLE
+/**
+ * @brief set compiled commands, table used instead of commands list for search and callbacks
+ * pass NULL to use commands list again
+ *
+ * @param manager
+ * @param table
+ */
+void CmdManager_setTable(CmdManager* manager, const Cmd_Table* table) {
+    manager->Table = table;
+}
+#endif // CMD_TABLE
+/**
+ * @brief set pattern types
+ *
+ * @param manager
+ * @param patterns
+ */
+void CmdManager_setPatternTypes(CmdManager* manager, Cmd_PatternTypes* patterns) {
+    manager->PatternTypes = patterns;
+}
+#if CMD_STATS
+/**
+ * @brief return counters of manager
+ *
+ * @param manager
+ * @return Cmd_Stats*
+ */
+Cmd_Stats* CmdManager_getStats(CmdManager* manager) {
+    return &manager->Stats;
+}
+/**
+ * @brief reset counters of manager
+ *
+ * @param manager
+ */
+void CmdManager_resetStats(CmdManager* manager) {
+    Mem_set(&manager->Stats, 0x00, sizeof(Cmd_Stats));
+}
+#endif // CMD_STATS
+#if CMD_MANAGER_ARGS
+/**
+ * @brief set args for manager
+ *
+ * @param manager
+ * @param args
+ */
+void CmdManager_setArgs(CmdManager* manager, void* args) {
+    manager->Args = args;
+}
+/**
+ * @brief get args for manager
+ *
+ * @param manager
+ * @return void*
+ */
+void* CmdManager_getArgs(CmdManager* manager) {
+    return manager->Args;
+}
+#endif
+#if CMD_STREAM
+/**
+ * @brief process incoming messages
+ *
+ * @param manager
+ * @param stream
+ */
+void CmdManager_handle(CmdManager* manager, IStream* stream) {
+    Param_Cursor cursor;
+    char buffer[CMD_HANDLE_BUFFER_SIZE];
+
+    CmdManager_handleStatic(manager, stream, buffer, sizeof(buffer), &cursor);
+}
+/**
+ * @brief process incoming messages with static buffer and cursor for memory safety
+ *
+ * @param manager
+ * @param stream
+ * @param buffer
+ * @param len
+ * @param cursor
+ */
+void CmdManager_handleStatic(CmdManager* manager, IStream* stream, char* buffer, Str_LenType len, Param_Cursor* cursor) {
+    if (IStream_available(stream) > 0) {
+    #if CMD_CHUNK
+        CmdManager_handleChunk(manager, stream, buffer, len, cursor);
+    #else
+        Stream_LenType lineLen = IStream_readBytesUntilPattern(stream, (const uint8_t*) manager->EndWith->Text, manager->EndWith->Len, (uint8_t*) buffer, len);
+        if (lineLen > 0) {
+            __capture(manager, buffer, lineLen);
+            lineLen -= manager->EndWith->Len;
+            // check end with for overflow error
+            if (Str_compareFix((const char*) &buffer[lineLen], (const char*) manager->EndWith->Text, manager->EndWith->Len) != 0) {
+                if (manager->bufferOverflow) {
+                    manager->bufferOverflow(manager);
+                }
+                return;
+            }
+            // remove endWith
+            buffer[lineLen] = '\0';
+            // check it's empty line or not
+            if(lineLen == 0) {
+                return;
+            }
+            CmdManager_processLine(manager, buffer, lineLen, cursor);
+        }
+    #endif // CMD_CHUNK
+    }
+}
+#endif // CMD_STREAM
+#if CMD_PRIORITY
+/**
+ * @brief process complete lines of stream that fit in buffer as a batch
+ * first pending lines that all statements have Cmd_Option_Priority run and skip later,
+ * scan stop at lines that may take next lines or not found, then commands with
+ * Cmd_Option_Priority of batch run before others, order of each class keep,
+ * if a command return Cmd_Continue, rest of statements pass to it one by one,
+ * stream must read only by this function while priority lines are pending
+ *
+ * @param manager
+ * @param stream
+ * @param buffer hold all lines of batch
+ * @param len
+ * @param cursor
+ */
+void CmdManager_handleBatch(CmdManager* manager, IStream* stream, char* buffer, Str_LenType len, Param_Cursor* cursor) {
+    Cmd_Statement statements[CMD_BATCH_SIZE];
+    Stream_LenType endLen = manager->EndWith->Len;
+    Stream_LenType lineLen;
+    Mem_LenType count = 0;
+    char* end;
+
+    if (manager->InUseFn == NULL) {
+        CmdManager_runPriority(manager, stream, buffer, len, cursor);
+    }
+    // multi line commands and long lines use normal path
+    lineLen = IStream_findPattern(stream, (const uint8_t*) manager->EndWith->Text, endLen);
+    if (manager->InUseFn != NULL || lineLen < 0 || lineLen + endLen >= len) {
+        CmdManager_handleStatic(manager, stream, buffer, len, cursor);
+        return;
+    }
+    do {
+        IStream_readBytes(stream, (uint8_t*) buffer, lineLen + endLen);
+        if (CmdManager_drainLine(manager, lineLen + endLen)) {
+            // run before by CmdManager_runPriority
+            lineLen = IStream_findPattern(stream, (const uint8_t*) manager->EndWith->Text, endLen);
+            continue;
+        }
+        __capture(manager, buffer, lineLen + endLen);
+        buffer[lineLen] = '\0';
+    #if CMD_BOUNDED
+        // reject before any scan, same as CmdManager_processLine
+        if (lineLen > CMD_LINE_MAX_LEN) {
+            if (manager->bufferOverflow) {
+                manager->bufferOverflow(manager);
+            }
+            lineLen = IStream_findPattern(stream, (const uint8_t*) manager->EndWith->Text, endLen);
+            continue;
+        }
+    #endif // CMD_BOUNDED
+    #if CMD_RATE_LIMIT
+        // shed after framing, same as CmdManager_processLine
+        if (!CmdManager_admit(manager, &manager->Limit, NULL, buffer)) {
+        #if CMD_AUDIT
+            CmdManager_audit(manager, buffer, lineLen, NULL, Cmd_Result_Shed);
+        #endif
+            lineLen = IStream_findPattern(stream, (const uint8_t*) manager->EndWith->Text, endLen);
+            continue;
+        }
+    #endif // CMD_RATE_LIMIT
+    #if CMD_REMOVE_BACKSPACE
+        lineLen = Str_removeBackspaceFix(buffer, lineLen);
+    #endif // CMD_REMOVE_BACKSPACE
+        end = buffer + lineLen;
+        while (buffer < end && *buffer != '\0') {
+            if (count == CMD_BATCH_SIZE) {
+                CmdManager_processBatch(manager, statements, count, cursor);
+                count = 0;
+            }
+            count += CmdManager_splitStatements(manager, &buffer, end, &statements[count], CMD_BATCH_SIZE - count);
+        }
+        // keep null terminator of line
+        buffer = end + 1;
+        len -= lineLen + 1;
+        lineLen = IStream_findPattern(stream, (const uint8_t*) manager->EndWith->Text, endLen);
+    } while (count < CMD_BATCH_SIZE && lineLen >= 0 && lineLen + endLen < len);
+    CmdManager_processBatch(manager, statements, count, cursor);
+}
+/**
+ * @brief scan pending lines of stream after last scan and run lines that all statements
+ * have Cmd_Option_Priority, their offsets keep until drain
+ *
+ * @param manager
+ * @param stream
+ * @param buffer temp buffer for copy of each line
+ * @param len
+ * @param cursor
+ */
+static void CmdManager_runPriority(CmdManager* manager, IStream* stream, char* buffer, Str_LenType len, Param_Cursor* cursor) {
+    Stream_LenType endLen = manager->EndWith->Len;
+    Stream_LenType offset = manager->Scanned;
+    Stream_LenType lineLen;
+    uint8_t skip = 0;
+    uint8_t index;
+    uint8_t lines;
+    int8_t priority;
+
+    // skips before scanned bytes
+    while (skip < manager->SkipsLen && manager->Skips[skip] < offset) {
+        skip++;
+    }
+    for (lines = 0; lines < CMD_PRIORITY_LINES; lines++) {
+        lineLen = IStream_findPatternAt(stream, offset, (const uint8_t*) manager->EndWith->Text, endLen);
+        if (lineLen < 0) {
+            break;
+        }
+        lineLen -= offset;
+        // long lines use normal path
+        if (lineLen + endLen >= len) {
+            break;
+        }
+        if (skip < manager->SkipsLen && manager->Skips[skip] == offset) {
+            skip++;
+        }
+        else {
+            IStream_getBytesAt(stream, offset, (uint8_t*) buffer, lineLen + endLen);
+            buffer[lineLen] = '\0';
+            priority = CmdManager_classifyLine(manager, buffer, lineLen);
+            if (priority < 0) {
+                break;
+            }
+            if (priority > 0) {
+                if (manager->SkipsLen == CMD_PRIORITY_LINES) {
+                    break;
+                }
+                // keep offsets in order
+                for (index = manager->SkipsLen; index > skip; index--) {
+                    manager->Skips[index] = manager->Skips[index - 1];
+                }
+                manager->Skips[skip++] = offset;
+                manager->SkipsLen++;
+                // classify modify copy, run original bytes
+                IStream_getBytesAt(stream, offset, (uint8_t*) buffer, lineLen + endLen);
+                __capture(manager, buffer, lineLen + endLen);
+                buffer[lineLen] = '\0';
+                CmdManager_processLine(manager, buffer, lineLen, cursor);
+            }
+        }
+        offset += lineLen + endLen;
+        manager->Scanned = offset;
+    }
+}
+/**
+ * @brief check statements of a line
+ *
+ * @param manager
+ * @param buffer
+ * @param lineLen
+ * @return int8_t 1 if all statements have Cmd_Option_Priority, 0 for normal line,
+ * -1 if a statement may take next lines or not found
+ */
+static int8_t CmdManager_classifyLine(CmdManager* manager, char* buffer, Str_LenType lineLen) {
+    Cmd_Statement statements[CMD_BATCH_SIZE];
+    Cmd_Statement* statement;
+    char* end;
+    Mem_LenType len;
+    Mem_LenType index;
+    Mem_LenType count = 0;
+    uint8_t normal = 0;
+    int8_t result = 0;
+
+#if CMD_BOUNDED
+    if (lineLen > CMD_LINE_MAX_LEN) {
+        return -1;
+    }
+#endif // CMD_BOUNDED
+#if CMD_REMOVE_BACKSPACE
+    lineLen = Str_removeBackspaceFix(buffer, lineLen);
+#endif // CMD_REMOVE_BACKSPACE
+    end = buffer + lineLen;
+    __enter(manager);
+    while (result == 0 && buffer < end && *buffer != '\0') {
+        len = CmdManager_splitStatements(manager, &buffer, end, statements, CMD_BATCH_SIZE);
+        for (index = 0; index < len; index++) {
+            statement = &statements[index];
+            statement->Result = CmdManager_parseHead(manager, statement->Ptr, statement->Len, &statement->Head);
+            if (statement->Result == Cmd_HeadResult_NotFound ||
+                (statement->Result == Cmd_HeadResult_Found && __mayContinue(&statement->Head))) {
+                result = -1;
+                break;
+            }
+            if (statement->Result != Cmd_HeadResult_Found ||
+                (statement->Head.Options & Cmd_Option_Priority) == 0) {
+                normal = 1;
+            }
+            count++;
+        }
+    }
+    __leave(manager);
+    if (result == 0 && count > 0 && !normal) {
+        result = 1;
+    }
+    return result;
+}
+/**
+ * @brief update offsets of pending lines after read a line
+ *
+ * @param manager
+ * @param len length of read line with EndWith
+ * @return uint8_t 1 if line run before by CmdManager_runPriority
+ */
+static uint8_t CmdManager_drainLine(CmdManager* manager, Stream_LenType len) {
+    uint8_t skip = manager->SkipsLen > 0 && manager->Skips[0] == 0;
+    uint8_t index;
+
+    if (skip) {
+        manager->SkipsLen--;
+    }
+    for (index = 0; index < manager->SkipsLen; index++) {
+        manager->Skips[index] = manager->Skips[index + skip] - len;
+    }
+    manager->Scanned = manager->Scanned > len ? manager->Scanned - len : 0;
+    return skip;
+}
+/**
+ * @brief dispatch high priority statements then others
+ * first pass stop at statements that may take next statements or not found
+ *
+ * @param manager
+ * @param statements
+ * @param len
+ * @param cursor
+ */
+static void CmdManager_processBatch(CmdManager* manager, Cmd_Statement* statements, Mem_LenType len, Param_Cursor* cursor) {
+    Cmd_Statement* statement;
+    Mem_LenType index;
+    uint8_t pass;
+
+    __enter(manager);
+    for (index = 0; index < len; index++) {
+        statements[index].Dispatched = 0;
+    }
+    for (pass = 0; pass < 2; pass++) {
+        for (index = 0; index < len; index++) {
+            statement = &statements[index];
+            if (statement->Dispatched) {
+                continue;
+            }
+            if (manager->InUseFn == NULL) {
+                // first pass only run high priority commands
+                if (pass == 0) {
+                    if (statement->Result == Cmd_HeadResult_None) {
+                        statement->Result = CmdManager_parseHead(manager, statement->Ptr, statement->Len, &statement->Head);
+                    }
+                    // next statements may be payload of it or stop by it
+                    if (statement->Result == Cmd_HeadResult_NotFound ||
+                        (statement->Result == Cmd_HeadResult_Found && __mayContinue(&statement->Head))) {
+                        break;
+                    }
+                    if (statement->Result != Cmd_HeadResult_Found ||
+                        (statement->Head.Options & Cmd_Option_Priority) == 0) {
+                        continue;
+                    }
+                }
+            #if CMD_COALESCE
+                if (CmdManager_isSuperseded(manager, statements, index, len)) {
+                    manager->Stats.Coalesced++;
+                    statement->Dispatched = 1;
+                    continue;
+                }
+            #endif // CMD_COALESCE
+            }
+            statement->Dispatched = 1;
+        #if CMD_STATEMENT
+            if (CmdManager_processStatement(manager, statement, cursor) != Cmd_Result_Done &&
+                manager->StopOnError) {
+                // stop both passes
+                pass = 1;
+                break;
+            }
+        #else
+            CmdManager_processStatement(manager, statement, cursor);
+        #endif // CMD_STATEMENT
+        }
+    }
+    __leave(manager);
+}
+#endif // CMD_PRIORITY
+/**
+ * @brief process string buffer
+ *
+ * @param manager
+ * @param buffer
+ * @param lineLen
+ * @param cursor
+ */
+char* CmdManager_process(CmdManager* manager, char* buffer, Str_LenType len, Param_Cursor* cursor) {
+    if (len > 0) {
+        // read line
+        Str_LenType lineLen = Str_posOf(buffer, *manager->EndWith->Text);
+        if (lineLen > 0) {
+            // check end with for overflow error
+            if (Str_compareFix((const char*) &buffer[lineLen], (const char*) manager->EndWith->Text, manager->EndWith->Len) != 0) {
+                if (manager->bufferOverflow) {
+                    manager->bufferOverflow(manager);
+                }
+                return NULL;
+            }
+            __capture(manager, buffer, lineLen + manager->EndWith->Len);
+            // remove endWith
+            buffer[lineLen] = '\0';
+            // check it's empty line or not
+            if(lineLen == 0) {
+                return NULL;
+            }
+            // process line
+            CmdManager_processLine(manager, buffer, lineLen, cursor);
+            // return end of line
+            return &buffer[lineLen + manager->EndWith->Len];
+        }
+    }
+    return NULL;
+}
+/**
+ * @brief process single line without check ending pattern
+ *
+ * @param manager
+ * @param buffer
+ * @param len
+ * @param cursor
+ */
+void CmdManager_processLine(CmdManager* manager, char* buffer, Str_LenType lineLen, Param_Cursor* cursor) {
+    Cmd_Statement statement;
+
+#if CMD_BOUNDED
+    // reject before any scan
+    if (lineLen > CMD_LINE_MAX_LEN) {
+        if (manager->bufferOverflow) {
+            manager->bufferOverflow(manager);
+        }
+        return;
+    }
+#endif // CMD_BOUNDED
+#if CMD_RATE_LIMIT
+    // shed after framing, lines of in use command belong to an admitted command
+    if (manager->InUseFn == NULL &&
+        !CmdManager_admit(manager, &manager->Limit, NULL, buffer)) {
+    #if CMD_AUDIT
+        CmdManager_audit(manager, buffer, lineLen, NULL, Cmd_Result_Shed);
+    #endif
+        return;
+    }
+#endif // CMD_RATE_LIMIT
+    __enter(manager);
+#if CMD_REMOVE_BACKSPACE
+    // remove backspaces
+#if CMD_CHAR_CLASS
+    // tokenizer remove backspaces of single command lines
+    if (manager->CharClass == NULL || manager->InUseFn != NULL
+    #if CMD_STATEMENT
+        || manager->StatementSeparator != '\0'
+    #endif
+    )
+#endif // CMD_CHAR_CLASS
+    lineLen = Str_removeBackspaceFix(buffer, lineLen);
+#endif // CMD_REMOVE_BACKSPACE
+#if CMD_STATEMENT
+    if (manager->StatementSeparator != '\0') {
+        CmdManager_processStatements(manager, buffer, lineLen, cursor);
+    }
+    else
+#endif // CMD_STATEMENT
+    {
+        statement.Ptr = buffer;
+        statement.Len = lineLen;
+        statement.Result = Cmd_HeadResult_None;
+        CmdManager_processStatement(manager, &statement, cursor);
+    }
+    __leave(manager);
+}
+/**
+ * @brief process single command
+ *
+ * @param manager
+ * @param statement
+ * @param cursor
+ * @return Cmd_Result
+ */
+static Cmd_Result CmdManager_processStatement(CmdManager* manager, Cmd_Statement* statement, Param_Cursor* cursor) {
+    Cmd_Result result = Cmd_Result_NotFound;
+#if CMD_RATE_LIMIT
+    Cmd_Limit* limit;
+#endif
+#if CMD_AUDIT
+    char line[CMD_AUDIT_LINE_MAX];
+    Str_LenType lineLen = 0;
+#endif
+    // check it's from last cmd or it's new cmd
+    if (manager->InUseFn == NULL) {
+    #if CMD_AUDIT
+        // callbacks modify statement, keep original bytes
+        if (manager->audit) {
+            lineLen = __min(statement->Len, CMD_AUDIT_LINE_MAX);
+            Mem_copy(line, statement->Ptr, lineLen);
+        }
+    #endif
+        if (statement->Result == Cmd_HeadResult_None) {
+            statement->Result = CmdManager_parseHead(manager, statement->Ptr, statement->Len, &statement->Head);
+        }
+        switch (statement->Result) {
+            case Cmd_HeadResult_Found:
+            #if CMD_RATE_LIMIT
+                limit = CmdManager_limit(manager, statement->Head.Index, CmdManager_key(manager, statement->Head.Index));
+                if (limit != NULL && !CmdManager_admit(manager, limit, statement->Head.Cmd, statement->Ptr)) {
+                    result = Cmd_Result_Shed;
+                    break;
+                }
+            #endif
+                result = CmdManager_dispatch(manager, &statement->Head, cursor);
+                break;
+            case Cmd_HeadResult_Ignore:
+                return Cmd_Result_Done;
+            default:
+                break;
+        }
+        // run not found
+        if (result == Cmd_Result_NotFound && manager->notFound) {
+            manager->notFound(manager, statement->Ptr);
+        }
+    #if CMD_AUDIT
+        CmdManager_audit(manager, line, lineLen, statement->Result == Cmd_HeadResult_Found ? &statement->Head : NULL, result);
+    #endif
+        return result;
+    }
+    else {
+        Cmd_Handled handled;
+        cursor->Ptr = statement->Ptr;
+        cursor->Len = statement->Len;
+        cursor->ParamSeparator = manager->ParamSeparator;
+        cursor->Index = 0;
+        handled = manager->InUseFn(manager, manager->InUseCmd, cursor, (Cmd_Type) (1 << manager->InUseCmdTypeIndex));
+        if (handled != Cmd_Continue) {
+            manager->InUseCmd = NULL;
+            manager->InUseFn = (Cmd_CallbackFn) NULL;
+        }
+        return handled == Cmd_Error ? Cmd_Result_Error : Cmd_Result_Done;
+    }
+}
+#if CMD_STATEMENT
+/**
+ * @brief split line with statement separator and process each statement in order
+ * statements split in windows of CMD_BATCH_SIZE, separators between double quotes ignored,
+ * after a multi line command rest of line pass to it without split
+ *
+ * @param manager
+ * @param buffer
+ * @param lineLen
+ * @param cursor
+ */
+static void CmdManager_processStatements(CmdManager* manager, char* buffer, Str_LenType lineLen, Param_Cursor* cursor) {
+    Cmd_Statement statements[CMD_BATCH_SIZE];
+    char* end = buffer + lineLen;
+    Mem_LenType len;
+    Mem_LenType index;
+
+    // multi line command get whole line
+    if (manager->InUseFn != NULL) {
+        statements[0].Ptr = buffer;
+        statements[0].Len = lineLen;
+        CmdManager_processStatement(manager, &statements[0], cursor);
+        return;
+    }
+    while (buffer < end && *buffer != '\0') {
+        len = CmdManager_splitStatements(manager, &buffer, end, statements, CMD_BATCH_SIZE);
+        for (index = 0; index < len; index++) {
+            if (manager->InUseFn != NULL) {
+                // rest of line belong to multi line command
+                CmdManager_joinStatements(manager, &statements[index], end, cursor);
+                return;
+            }
+        #if CMD_COALESCE
+            if (CmdManager_isSuperseded(manager, statements, index, len)) {
+                manager->Stats.Coalesced++;
+                continue;
+            }
+        #endif // CMD_COALESCE
+            if (CmdManager_processStatement(manager, &statements[index], cursor) != Cmd_Result_Done &&
+                manager->StopOnError) {
+                return;
+            }
+        }
+    }
+}
+/**
+ * @brief restore separators after statement and pass rest of line to multi line command
+ *
+ * @param manager
+ * @param statement
+ * @param end
+ * @param cursor
+ */
+static void CmdManager_joinStatements(CmdManager* manager, Cmd_Statement* statement, char* end, Param_Cursor* cursor) {
+    char* ptr = statement->Ptr;
+
+    while (ptr < end) {
+        if (*ptr == '\0') {
+            *ptr = manager->StatementSeparator;
+        }
+        ptr++;
+    }
+    statement->Len = (Str_LenType) (end - statement->Ptr);
+    CmdManager_processStatement(manager, statement, cursor);
+}
+#endif // CMD_STATEMENT
+#if CMD_STATEMENT || CMD_PRIORITY
+/**
+ * @brief split statements of line until fill statements array
+ * without statement separator whole line is single statement
+ *
+ * @param manager
+ * @param buffer start of line, move to first not split character
+ * @param end end of line
+ * @param statements
+ * @param len
+ * @return Mem_LenType number of statements
+ */
+static Mem_LenType CmdManager_splitStatements(CmdManager* manager, char** buffer, char* end, Cmd_Statement* statements, Mem_LenType len) {
+    char* start = *buffer;
+    char* ptr = start;
+    Mem_LenType count = 0;
+#if CMD_STATEMENT
+    uint8_t quote = 0;
+#endif
+    uint8_t last = 0;
+
+    while (!last && count < len) {
+        // find end of statement
+    #if CMD_STATEMENT
+        while (ptr < end && *ptr != '\0' && (quote || *ptr != manager->StatementSeparator)) {
+            // parser of params has no escape, backslash is normal character
+            if (*ptr == '"') {
+                quote = !quote;
+            }
+            ptr++;
+        }
+    #else
+        (void) manager;
+        while (ptr < end && *ptr != '\0') {
+            ptr++;
+        }
+    #endif // CMD_STATEMENT
+        last = ptr >= end || *ptr == '\0';
+        if (!last) {
+            *ptr = '\0';
+        }
+        // ignore empty statements
+        if (Str_ignoreWhitespace(start) != ptr) {
+            statements[count].Ptr = start;
+            statements[count].Len = (Str_LenType) (ptr - start);
+            statements[count].Result = Cmd_HeadResult_None;
+            count++;
+        }
+        start = last ? ptr : ++ptr;
+    }
+    *buffer = start;
+    return count;
+}
+#endif // CMD_STATEMENT || CMD_PRIORITY
+#if CMD_COALESCE
+/**
+ * @brief check Set statement overwrite by next Set of same cmd in statements
+ * commands with Cmd_Option_CoalesceKey also must have same first param,
+ * other types of same cmd between them keep the Set,
+ * statements between them must not stop the batch or take over rest of it
+ * and next Set must not shed by own rate limit, otherwise both run
+ *
+ * @param manager
+ * @param statements
+ * @param index
+ * @param len
+ * @return uint8_t
+ */
+static uint8_t CmdManager_isSuperseded(CmdManager* manager, Cmd_Statement* statements, Mem_LenType index, Mem_LenType len) {
+    Cmd_Statement* statement = &statements[index];
+    Cmd_Statement* next;
+#if CMD_RATE_LIMIT
+    Cmd_Limit* limit;
+#endif
+
+    CmdManager_resolveStatement(manager, statement);
+    if (statement->Result != Cmd_HeadResult_Found ||
+        statement->Head.TypeIndex != Cmd_TypeIndex_Set ||
+        (statement->Head.Options & (Cmd_Option_Coalesce | Cmd_Option_CoalesceKey)) == 0) {
+        return 0;
+    }
+    for (next = statement + 1; next < &statements[len]; next++) {
+        CmdManager_resolveStatement(manager, next);
+        if (next->Result == Cmd_HeadResult_Found && next->Head.Index == statement->Head.Index) {
+            // other types of same cmd must see this value
+            if (next->Head.TypeIndex != Cmd_TypeIndex_Set) {
+                return 0;
+            }
+            if ((statement->Head.Options & Cmd_Option_CoalesceKey) == 0 ||
+                CmdManager_compareKey(manager, &statement->Head, &next->Head) == 0) {
+            #if CMD_RATE_LIMIT
+                // shed Set not apply own value
+                limit = CmdManager_limit(manager, next->Head.Index, CmdManager_key(manager, next->Head.Index));
+                if (limit != NULL && limit->Burst != 0) {
+                    return 0;
+                }
+            #endif // CMD_RATE_LIMIT
+                return next->Head.Fn != NULL;
+            }
+        }
+        // any error stop rest of statements
+        if (__stopOnError(manager)) {
+            return 0;
+        }
+        // multi line command take next statements as payload
+        if (next->Result == Cmd_HeadResult_Found && __mayContinue(&next->Head)) {
+            return 0;
+        }
+    }
+    return 0;
+}
+static void CmdManager_resolveStatement(CmdManager* manager, Cmd_Statement* statement) {
+    if (statement->Result == Cmd_HeadResult_None) {
+        statement->Result = CmdManager_parseHead(manager, statement->Ptr, statement->Len, &statement->Head);
+    }
+}
+/**
+ * @brief compare first param of two statements
+ *
+ * @param manager
+ * @param a
+ * @param b
+ * @return Mem_CmpResult
+ */
+static Mem_CmpResult CmdManager_compareKey(CmdManager* manager, Cmd_Head* a, Cmd_Head* b) {
+    Str_LenType lenA = CmdManager_keyLen(manager, a);
+    Str_LenType lenB = CmdManager_keyLen(manager, b);
+
+    if (lenA != lenB) {
+        return lenA - lenB;
+    }
+    return Mem_compare(Str_ignoreWhitespace(a->Params), Str_ignoreWhitespace(b->Params), lenA);
+}
+static Str_LenType CmdManager_keyLen(CmdManager* manager, Cmd_Head* head) {
+    char* start = Str_ignoreWhitespace(head->Params);
+    char* end = head->Params + head->Len;
+    char* ptr = start;
+
+    while (ptr < end && *ptr != '\0' && *ptr != manager->ParamSeparator) {
+        ptr++;
+    }
+    // ignore whitespaces after key
+    while (ptr > start && (ptr[-1] == ' ' || ptr[-1] == '\t')) {
+        ptr--;
+    }
+    return (Str_LenType) (ptr - start);
+}
+#endif // CMD_COALESCE
+#if CMD_CHUNK
+/**
+ * @brief return which part of params passed to current callback
+ * commands without Cmd_Option_Chunked always get Cmd_Chunk_Whole
+ *
+ * @param manager
+ * @return Cmd_Chunk
+ */
+Cmd_Chunk CmdManager_getChunk(CmdManager* manager) {
+    return (Cmd_Chunk) manager->Chunk;
+}
+/**
+ * @brief read next line or chunk from stream
+ * lines that fit in buffer process normally, longer lines pass to command in chunks
+ * middle chunks wait for full buffer, so buffer must be smaller than stream buffer,
+ * last chunk may be empty when EndWith not fit with rest of params
+ *
+ * @param manager
+ * @param stream
+ * @param buffer
+ * @param len
+ * @param cursor
+ */
+static void CmdManager_handleChunk(CmdManager* manager, IStream* stream, char* buffer, Str_LenType len, Param_Cursor* cursor) {
+    Stream_LenType endLen = manager->EndWith->Len;
+    Stream_LenType pos = IStream_findPattern(stream, (const uint8_t*) manager->EndWith->Text, endLen);
+    Stream_LenType lineLen;
+    Cmd_Head head;
+    uint8_t first = manager->ChunkState == Cmd_ChunkState_Idle;
+
+    if (first && pos >= 0 && pos + endLen <= len) {
+        // line fit in buffer
+        IStream_readBytes(stream, (uint8_t*) buffer, pos + endLen);
+        __capture(manager, buffer, pos + endLen);
+        buffer[pos] = '\0';
+        if (pos > 0) {
+            CmdManager_processLine(manager, buffer, pos, cursor);
+        }
+        return;
+    }
+    // keep one byte for null terminator
+    len--;
+    if (pos >= 0 && pos + endLen <= len) {
+        lineLen = pos + endLen;
+    }
+    else {
+        if (pos >= 0) {
+            // EndWith not fit, pass bytes before it, EndWith read with last chunk
+            lineLen = pos < len ? pos : len;
+        }
+        else {
+            // don't split EndWith between chunks
+            lineLen = IStream_available(stream) - (endLen - 1);
+            if (lineLen < len) {
+                return;
+            }
+            lineLen = len;
+        }
+        pos = -1;
+    }
+    IStream_readBytes(stream, (uint8_t*) buffer, lineLen);
+    __capture(manager, buffer, lineLen);
+    manager->Chunk = (first ? Cmd_Chunk_First : Cmd_Chunk_None) | (pos >= 0 ? Cmd_Chunk_Last : Cmd_Chunk_None);
+    if (pos >= 0) {
+        lineLen = pos;
+    }
+    buffer[lineLen] = '\0';
+    // first chunk, resolve cmd and type
+    if (first) {
+        manager->ChunkState = Cmd_ChunkState_Drop;
+        if (manager->InUseFn != NULL) {
+            // long line of multi line command
+            manager->ChunkCmd = manager->InUseCmd;
+            manager->ChunkFn = manager->InUseFn;
+            manager->ChunkTypeIndex = manager->InUseCmdTypeIndex;
+            manager->ChunkState = Cmd_ChunkState_Stream;
+        }
+        else {
+            __enter(manager);
+            if (CmdManager_parseHead(manager, buffer, lineLen, &head) == Cmd_HeadResult_Found &&
+                (head.Options & Cmd_Option_Chunked) != 0 &&
+                CmdManager_dispatch(manager, &head, cursor) != Cmd_Result_NotFound) {
+                manager->ChunkCmd = head.Cmd;
+                manager->ChunkFn = head.Fn;
+                manager->ChunkTypeIndex = head.CallbackIndex;
+                manager->ChunkState = Cmd_ChunkState_Stream;
+                manager->InUseCmd = NULL;
+                manager->InUseFn = (Cmd_CallbackFn) NULL;
+                buffer = NULL;
+            }
+            else if (manager->bufferOverflow) {
+                manager->bufferOverflow(manager);
+            }
+            __leave(manager);
+        }
+    }
+    if (manager->ChunkState == Cmd_ChunkState_Stream && buffer != NULL) {
+        cursor->Ptr = buffer;
+        cursor->Len = lineLen;
+        cursor->ParamSeparator = manager->ParamSeparator;
+        cursor->Index = 0;
+        if (manager->ChunkFn(manager, manager->ChunkCmd, cursor, (Cmd_Type) (1 << manager->ChunkTypeIndex)) != Cmd_Continue) {
+            manager->InUseCmd = NULL;
+            manager->InUseFn = (Cmd_CallbackFn) NULL;
+        }
+        else {
+            manager->InUseCmd = manager->ChunkCmd;
+            manager->InUseFn = manager->ChunkFn;
+            manager->InUseCmdTypeIndex = manager->ChunkTypeIndex;
+        }
+    }
+    if (pos >= 0) {
+        manager->ChunkState = Cmd_ChunkState_Idle;
+        manager->Chunk = Cmd_Chunk_Whole;
+    }
+}
+#endif // CMD_CHUNK
+/**
+ * @brief find cmd and type of line
+ *
+ * @param manager
+ * @param buffer
+ * @param lineLen
+ * @param head
+ * @return Cmd_HeadResult
+ */
+static Cmd_HeadResult CmdManager_parseHead(CmdManager* manager, char* buffer, Str_LenType lineLen, Cmd_Head* head) {
+    Cmd_Str cmdStr;
+#if CMD_CHAR_CLASS
+    if (manager->CharClass != NULL) {
+        return CmdManager_tokenizeHead(manager, buffer, lineLen, head);
+    }
+#endif // CMD_CHAR_CLASS
+    // ignore whitspaces in start of frame
+    buffer = Str_ignoreWhitespace(buffer);
+    // check start with
+    if (manager->StartWith) {
+    #if CMD_CONVERT_START_WITH
+        __convert(buffer, manager->StartWith->Len);
+    #endif // CMD_CONVERT_START_WITH
+        if (Str_compareFix(buffer, manager->StartWith->Text, manager->StartWith->Len) == 0) {
+            buffer += manager->StartWith->Len;
+            // ignore whitspaces
+            buffer = Str_ignoreWhitespace(buffer);
+        }
+        else {
+            return Cmd_HeadResult_Ignore;
+        }
+    }
+    // find cmd name len
+    cmdStr.Text = buffer;
+    buffer = Str_ignoreNameCharacters(buffer);
+    cmdStr.Len = (Str_LenType) (buffer - cmdStr.Text);
+    lineLen -= cmdStr.Len;
+    // find cmd
+#if CMD_BOUNDED
+    if (cmdStr.Len > CMD_NAME_MAX_LEN) {
+        return Cmd_HeadResult_NotFound;
+    }
+#endif // CMD_BOUNDED
+    __convert((char*) cmdStr.Text, cmdStr.Len);
+    head->Index = CmdManager_findName(manager, &cmdStr);
+    if (head->Index == -1 || manager->PatternTypes == NULL) {
+        return Cmd_HeadResult_NotFound;
+    }
+    // ignore whitespaces between Cmd_Name and Cmd_Type
+    buffer = Str_ignoreWhitespace(buffer);
+    // find cmd type len
+    cmdStr.Text = buffer;
+    buffer = Str_ignoreCommandCharacters(buffer);
+    cmdStr.Len = (Str_LenType) (buffer - cmdStr.Text);
+    // find cmd type
+    head->TypeIndex = Mem_linearSearch(manager->PatternTypes->Patterns, CMD_TYPE_LEN, sizeof(Cmd_Str*), &cmdStr, CmdType_compare);
+    if (head->TypeIndex != -1) {
+        head->Params = buffer;
+        head->Len = lineLen - cmdStr.Len;
+    }
+    else {
+        // unknown type get whole type characters
+        head->Params = (char*) cmdStr.Text;
+        head->Len = lineLen;
+    }
+    CmdManager_resolveHead(manager, head);
+    return Cmd_HeadResult_Found;
+}
+#if CMD_CHAR_CLASS
+/**
+ * @brief find cmd and type of line in single pass with character class table,
+ * backspaces removed in same pass of rest of line, line parse again only if they remove part of head
+ *
+ * @param manager
+ * @param buffer
+ * @param lineLen
+ * @param head
+ * @return Cmd_HeadResult
+ */
+static Cmd_HeadResult CmdManager_tokenizeHead(CmdManager* manager, char* buffer, Str_LenType lineLen, Cmd_Head* head) {
+    char* end = buffer + lineLen;
+    char* ptr;
+    Cmd_Str cmdStr;
+    Cmd_Str typeStr;
+    Cmd_HeadResult result;
+#if CMD_REMOVE_BACKSPACE
+    const uint8_t* classes = manager->CharClass->Class;
+    char* out;
+    char* low;
+#endif
+
+    result = CmdManager_tokenizeName(manager, buffer, &cmdStr, &typeStr);
+    if (result != Cmd_HeadResult_Found) {
+        return result;
+    }
+    ptr = (char*) typeStr.Text + typeStr.Len;
+#if CMD_REMOVE_BACKSPACE
+    // head has no backspace, remove backspaces of rest of line in place
+    out = ptr;
+    low = ptr;
+    while (ptr < end) {
+        if (classes[(uint8_t) *ptr] & Cmd_Char_Backspace) {
+            if (out > buffer) {
+                out--;
+            }
+            if (out < low) {
+                low = out;
+            }
+        }
+        else {
+            *out++ = *ptr;
+        }
+        ptr++;
+    }
+    if (out < end) {
+        *out = '\0';
+        end = out;
+    }
+    ptr = (char*) typeStr.Text + typeStr.Len;
+    if (low < ptr) {
+        // rare, backspaces remove part of head, line has no backspace now
+        result = CmdManager_tokenizeName(manager, buffer, &cmdStr, &typeStr);
+        if (result != Cmd_HeadResult_Found) {
+            return result;
+        }
+        ptr = (char*) typeStr.Text + typeStr.Len;
+    }
+#endif // CMD_REMOVE_BACKSPACE
+    head->Index = CmdManager_findName(manager, &cmdStr);
+    if (head->Index == -1 || manager->PatternTypes == NULL) {
+        return Cmd_HeadResult_NotFound;
+    }
+    head->TypeIndex = Mem_linearSearch(manager->PatternTypes->Patterns, CMD_TYPE_LEN, sizeof(Cmd_Str*), &typeStr, CmdType_compare);
+    if (head->TypeIndex != -1) {
+        head->Params = ptr;
+    }
+    else {
+        // unknown type get whole type characters
+        head->Params = (char*) typeStr.Text;
+    }
+    head->Len = (Str_LenType) (end - head->Params);
+    CmdManager_resolveHead(manager, head);
+    return Cmd_HeadResult_Found;
+}
+/**
+ * @brief skip whitespaces and StartWith, find name and type of line, stop on first backspace
+ *
+ * @param manager
+ * @param buffer
+ * @param cmdStr
+ * @param typeStr
+ * @return Cmd_HeadResult Cmd_HeadResult_Found if name and type scanned
+ */
+static Cmd_HeadResult CmdManager_tokenizeName(CmdManager* manager, char* buffer, Cmd_Str* cmdStr, Cmd_Str* typeStr) {
+    const uint8_t* classes = manager->CharClass->Class;
+    char* ptr = buffer;
+    uint8_t charClass;
+
+    // ignore whitspaces in start of frame
+    while ((charClass = classes[(uint8_t) *ptr]) & Cmd_Char_Space) {
+        ptr++;
+    }
+    // check start with
+    if (manager->StartWith && (charClass & Cmd_Char_Backspace) == 0) {
+    #if CMD_CONVERT_START_WITH
+        __convert(ptr, manager->StartWith->Len);
+    #endif // CMD_CONVERT_START_WITH
+        if (Str_compareFix(ptr, manager->StartWith->Text, manager->StartWith->Len) != 0) {
+            return Cmd_HeadResult_Ignore;
+        }
+        ptr += manager->StartWith->Len;
+        while ((charClass = classes[(uint8_t) *ptr]) & Cmd_Char_Space) {
+            ptr++;
+        }
+    }
+    // find cmd name and convert it
+    cmdStr->Text = ptr;
+    while (charClass & Cmd_Char_Name) {
+        if (charClass & Cmd_Char_Fold) {
+            *ptr ^= 0x20;
+        }
+        charClass = classes[(uint8_t) *++ptr];
+    }
+    cmdStr->Len = (Str_LenType) (ptr - cmdStr->Text);
+#if CMD_BOUNDED
+    if (cmdStr->Len > CMD_NAME_MAX_LEN) {
+        return Cmd_HeadResult_NotFound;
+    }
+#endif // CMD_BOUNDED
+    // ignore whitespaces between Cmd_Name and Cmd_Type
+    while (charClass & Cmd_Char_Space) {
+        charClass = classes[(uint8_t) *++ptr];
+    }
+    // find cmd type
+    typeStr->Text = ptr;
+    while (charClass & Cmd_Char_Type) {
+        charClass = classes[(uint8_t) *++ptr];
+    }
+    typeStr->Len = (Str_LenType) (ptr - typeStr->Text);
+    return Cmd_HeadResult_Found;
+}
+#endif // CMD_CHAR_CLASS
+/**
+ * @brief find index of cmd name in table or list
+ *
+ * @param manager
+ * @param name
+ * @return Mem_LenType -1 if not found
+ */
+static Mem_LenType CmdManager_findName(CmdManager* manager, Cmd_Str* name) {
+#if CMD_TABLE
+    if (manager->Table) {
+        return CmdTable_find(manager->Table, name);
+    }
+#endif // CMD_TABLE
+    return __search(manager->List.Cmds, manager->List.Len, sizeof(manager->List.Cmds[0]), name, Cmd_compareName);
+}
+#if CMD_RATE_LIMIT || CMD_CACHE
+/**
+ * @brief find index and key of command by name in current version of commands
+ *
+ * @param manager
+ * @param name null terminated name
+ * @param key key of found command
+ * @return Mem_LenType -1 if not found
+ */
+static Mem_LenType CmdManager_findCmd(CmdManager* manager, const char* name, const void** key) {
+    Cmd_Str str;
+    Mem_LenType index;
+
+    str.Text = name;
+    str.Len = Str_len(name);
+    __enter(manager);
+    index = CmdManager_findName(manager, &str);
+    if (index != -1) {
+        *key = CmdManager_key(manager, index);
+    }
+    __leave(manager);
+    return index;
+}
+/**
+ * @brief return key of command in current list or table, limits and cache entries keep it
+ *
+ * @param manager
+ * @param index index of command
+ * @return const void* cmd object or name in table
+ */
+static const void* CmdManager_key(CmdManager* manager, Mem_LenType index) {
+#if CMD_TABLE
+    const Cmd_Table* table = manager->Table;
+    if (table) {
+        return table->Cmds ? (const void*) CmdList_get(table->Cmds, index) : (const void*) &table->Names[table->NameOffsets[index]];
+    }
+#endif // CMD_TABLE
+    return CmdList_get(manager->List.Cmds, index);
+}
+#endif
+/**
+ * @brief find cmd object, options and callback of found cmd
+ *
+ * @param manager
+ * @param head
+ */
+static void CmdManager_resolveHead(CmdManager* manager, Cmd_Head* head) {
+    Cmd_Type type;
+    uint8_t types;
+
+#if CMD_TABLE
+    const Cmd_Table* table = manager->Table;
+    if (table) {
+        head->Cmd = table->Cmds ? CmdList_get(table->Cmds, head->Index) : NULL;
+        types = table->Types[head->Index];
+    #if CMD_OPTIONS
+        head->Options = table->Options[head->Index];
+    #endif
+    }
+    else
+#endif // CMD_TABLE
+    {
+        head->Cmd = CmdList_get(manager->List.Cmds, head->Index);
+        types = head->Cmd->Types.Flags;
+    #if CMD_OPTIONS
+        head->Options = head->Cmd->Options.Flags;
+    #endif
+    }
+    head->Fn = NULL;
+    if (head->TypeIndex != -1) {
+        head->CallbackIndex = (uint8_t) head->TypeIndex;
+    }
+    else {
+    #if CMD_TYPE_UNKNOWN
+        head->CallbackIndex = Cmd_TypeIndex_Unknown;
+    #else
+        return;
+    #endif // CMD_TYPE_UNKNOWN
+    }
+    type = (Cmd_Type) (1 << head->CallbackIndex);
+    if ((types & type) == 0) {
+        return;
+    }
+#if CMD_TABLE
+    if (table) {
+        head->Fn = CmdTable_getCallback(table, head->Index, head->CallbackIndex);
+        return;
+    }
+#endif // CMD_TABLE
+    head->Fn = Cmd_getCallback(head->Cmd, head->CallbackIndex);
+}
+/**
+ * @brief call callback of cmd type if cmd support it
+ *
+ * @param manager
+ * @param head
+ * @param cursor
+ * @return Cmd_Result
+ */
+static Cmd_Result CmdManager_dispatch(CmdManager* manager, Cmd_Head* head, Param_Cursor* cursor) {
+    Cmd_Handled handled;
+#if CMD_CACHE
+    Cmd_CacheEntry* entry = NULL;
+#endif
+
+    if (head->Fn == NULL) {
+        return Cmd_Result_NotFound;
+    }
+#if CMD_CACHE
+    entry = CmdManager_cacheEntry(manager, head->Index, CmdManager_key(manager, head->Index));
+    if (entry != NULL) {
+        if (head->TypeIndex == Cmd_TypeIndex_Get && entry->TTL != 0) {
+            if (entry->Valid && manager->Ticks - entry->Time < entry->TTL) {
+                // serve from cache without callback
+                manager->Stats.CacheHits++;
+                if (manager->respond) {
+                    manager->respond(manager, entry->Buffer, entry->Len);
+                }
+                return Cmd_Result_Done;
+            }
+            entry->Valid = 0;
+            entry->Len = 0;
+            entry->Time = manager->Ticks;
+            manager->Recording = entry;
+        }
+    }
+#endif // CMD_CACHE
+    cursor->Ptr = head->Params;
+    cursor->Len = head->Len;
+    cursor->ParamSeparator = manager->ParamSeparator;
+    cursor->Index = 0;
+    handled = head->Fn(manager, head->Cmd, cursor, head->TypeIndex != -1 ? (Cmd_Type) (1 << head->TypeIndex) : Cmd_Type_None);
+#if CMD_CACHE
+    if (manager->Recording) {
+        // only complete response of single line Get is valid
+        entry->Valid = handled == Cmd_Done;
+        manager->Recording = NULL;
+    }
+#if CMD_TYPE_SET
+    else if (entry != NULL && head->TypeIndex == Cmd_TypeIndex_Set && handled != Cmd_Error) {
+        entry->Valid = 0;
+    }
+#endif
+#endif // CMD_CACHE
+    if (handled == Cmd_Continue) {
+        manager->InUseCmd = head->Cmd;
+        manager->InUseFn = head->Fn;
+        manager->InUseCmdTypeIndex = head->CallbackIndex;
+    }
+    return handled == Cmd_Error ? Cmd_Result_Error : Cmd_Result_Done;
+}
+static Cmd_CallbackFn Cmd_getCallback(Cmd* cmd, uint8_t typeIndex) {
+#if CMD_MULTI_CALLBACK
+#if CMD_TYPE_UNKNOWN
+    if (typeIndex == Cmd_TypeIndex_Unknown) {
+        return cmd->Callbacks.unknown;
+    }
+#endif // CMD_TYPE_UNKNOWN
+    return cmd->Callbacks.fn[typeIndex];
+#else
+    return cmd->Callbacks.fn[0];
+#endif // CMD_MULTI_CALLBACK
+}
+static Mem_CmpResult Cmd_compareName(const void* name, const void* cmd, Mem_LenType itemLen) {
+    Mem_LenType len = __max(__castStr(name)->Len, __castCmd(cmd)->CmdName.Len);
+#if CMD_BOUNDED
+    // name not longer than CMD_NAME_MAX_LEN, so names differ in this range
+    len = __min(len, CMD_NAME_MAX_LEN + 1);
+#endif
+
+    return Mem_compare(__castStr(name)->Text, __castCmd(cmd)->CmdName.Text, len);
+}
+static Mem_CmpResult CmdType_compare(const void* name, const void* type, Mem_LenType itemLen) {
+    Mem_LenType len = __max(__castStr(name)->Len, __castStrPtr(type)->Len);
+
+    return Mem_compare(__castStr(name)->Text, __castStrPtr(type)->Text, len);
+}
+#if CMD_SORT_LIST
+static void Cmd_swap(void* itemA, void* itemB, Mem_LenType itemLen) {
+#if CMD_LIST_MODE == CMD_LIST_ARRAY
+    Cmd temp;
+    Mem_copy((uint8_t*) &temp, itemA, itemLen);
+    Mem_copy(itemA, itemB, itemLen);
+    Mem_copy(itemB, (uint8_t*) &temp, itemLen);
+#else
+    Cmd* temp;
+    Mem_copy(&temp, itemA, itemLen);
+    Mem_copy(itemA, itemB, itemLen);
+    Mem_copy(itemB, &temp, itemLen);
+#endif // CMD_LIST_MODE
+}
+static Mem_CmpResult Cmd_compare(const void* itemA, const void* itemB, Mem_LenType itemLen) {
+    return Str_compare(__castCmd(itemA)->CmdName.Text, __castCmd(itemB)->CmdName.Text);
+}
+#endif // CMD_SORT_LIST
+#if CMD_TABLE
+/**
+ * @brief return size of memory that need for build table of commands
+ *
+ * @param cmds
+ * @param len
+ * @return uint32_t
+ */
+uint32_t CmdTable_size(Cmd_Array* cmds, Cmd_LenType len) {
+    uint32_t callbacks;
+    uint32_t names;
+
+    CmdTable_count(cmds, len, &callbacks, &names);
+    return callbacks * (sizeof(Cmd_CallbackFn) + sizeof(uint16_t)) +
+           (uint32_t) len * (3 * sizeof(uint16_t) + __TABLE_BYTES) +
+           names;
+}
+/**
+ * @brief build table of commands in given memory, memory must be aligned for pointers
+ * same callbacks of commands store once in Symbols, Lookup sort for CmdTable_find
+ *
+ * @param table
+ * @param cmds
+ * @param len
+ * @param memory
+ * @param size size of memory, get it from CmdTable_size
+ * @return uint8_t 1 if table build, 0 if memory not enough or names too long
+ */
+uint8_t CmdTable_build(Cmd_Table* table, Cmd_Array* cmds, Cmd_LenType len, void* memory, uint32_t size) {
+    Cmd_CallbackFn* symbols;
+    uint16_t* nameOffsets;
+    uint16_t* callbackOffsets;
+    uint16_t* callbackIds;
+    uint16_t* lookup;
+    uint8_t* keys;
+    uint8_t* nameLens;
+    uint8_t* types;
+    uint8_t* masks;
+#if CMD_OPTIONS
+    uint8_t* options;
+#endif
+    char* names;
+    uint32_t callbacks;
+    uint32_t namesLen;
+    uint16_t symbolsLen = 0;
+    uint16_t callbackIndex = 0;
+    uint16_t nameOffset = 0;
+    uint16_t item;
+    Cmd_LenType index;
+    Cmd_LenType pos;
+    uint8_t typeIndex;
+
+    CmdTable_count(cmds, len, &callbacks, &namesLen);
+    if (CmdTable_size(cmds, len) > size || namesLen > 0xFFFF || callbacks > 0xFFFF) {
+        return 0;
+    }
+    // separate arrays, biggest items first for alignment
+    symbols = (Cmd_CallbackFn*) memory;
+    nameOffsets = (uint16_t*) &symbols[callbacks];
+    callbackOffsets = &nameOffsets[len];
+    lookup = &callbackOffsets[len];
+    callbackIds = &lookup[len];
+    keys = (uint8_t*) &callbackIds[callbacks];
+    nameLens = &keys[len];
+    types = &nameLens[len];
+    masks = &types[len];
+#if CMD_OPTIONS
+    options = &masks[len];
+    names = (char*) &options[len];
+#else
+    names = (char*) &masks[len];
+#endif
+    for (index = 0; index < len; index++) {
+        Cmd* cmd = CmdList_get(cmds, index);
+        if (cmd->CmdName.Len > 0xFF) {
+            return 0;
+        }
+        nameOffsets[index] = nameOffset;
+        nameLens[index] = (uint8_t) cmd->CmdName.Len;
+        keys[index] = CmdTable_hash(cmd->CmdName.Text, cmd->CmdName.Len);
+        Mem_copy(&names[nameOffset], cmd->CmdName.Text, cmd->CmdName.Len);
+        nameOffset += (uint16_t) cmd->CmdName.Len;
+        types[index] = cmd->Types.Flags;
+    #if CMD_OPTIONS
+        options[index] = cmd->Options.Flags;
+    #endif
+        // keep only exists callbacks
+        masks[index] = 0;
+        callbackOffsets[index] = callbackIndex;
+        for (typeIndex = 0; typeIndex < __CALLBACKS_LEN; typeIndex++) {
+            Cmd_CallbackFn fn = Cmd_getCallback(cmd, typeIndex);
+            uint16_t symbol = 0;
+            if (fn == NULL) {
+                continue;
+            }
+            while (symbol < symbolsLen && symbols[symbol] != fn) {
+                symbol++;
+            }
+            if (symbol == symbolsLen) {
+                symbols[symbolsLen++] = fn;
+            }
+            masks[index] |= (uint8_t) (1 << typeIndex);
+            callbackIds[callbackIndex++] = symbol;
+        }
+    }
+    table->Cmds = cmds;
+    table->Symbols = symbols;
+    table->NameOffsets = nameOffsets;
+    table->CallbackOffsets = callbackOffsets;
+    table->CallbackIds = callbackIds;
+    table->Keys = keys;
+    table->NameLens = nameLens;
+    table->Types = types;
+    table->CallbackMasks = masks;
+#if CMD_OPTIONS
+    table->Options = options;
+#endif
+    table->Names = names;
+    table->Len = len;
+    table->SymbolsLen = symbolsLen;
+    // insertion sort, same names keep order of list
+    for (index = 0; index < len; index++) {
+        item = index;
+        pos = index;
+        while (pos > 0 && CmdTable_compare(table, lookup[pos - 1], keys[item], &names[nameOffsets[item]], nameLens[item]) > 0) {
+            lookup[pos] = lookup[pos - 1];
+            pos--;
+        }
+        lookup[pos] = item;
+    }
+    table->Lookup = lookup;
+    return 1;
+}
+/**
+ * @brief find index of command name in table
+ *
+ * @param table
+ * @param name
+ * @return Mem_LenType index of command, -1 if not found
+ */
+Mem_LenType CmdTable_find(const Cmd_Table* table, const Cmd_Str* name) {
+#if !CMD_BOUNDED
+    const uint8_t* keys = table->Keys;
+    Cmd_LenType index;
+#endif
+    Mem_CmpResult result;
+    uint16_t low = 0;
+    uint16_t high = table->Len;
+    uint16_t mid;
+    uint8_t key;
+
+    if (name->Len > 0xFF) {
+        return -1;
+    }
+    key = CmdTable_hash(name->Text, name->Len);
+    if (table->Lookup == NULL) {
+    #if CMD_BOUNDED
+        // linear search has no bound, tables of CmdTable_build and CmdImage_load have lookup
+        return -1;
+    #else
+        for (index = 0; index < table->Len; index++) {
+            if (keys[index] == key &&
+                table->NameLens[index] == name->Len &&
+                Mem_compare(&table->Names[table->NameOffsets[index]], name->Text, name->Len) == 0) {
+                return (Mem_LenType) index;
+            }
+        }
+        return -1;
+    #endif // CMD_BOUNDED
+    }
+    while (low < high) {
+        mid = (uint16_t) ((low + high) >> 1);
+        result = CmdTable_compare(table, table->Lookup[mid], key, name->Text, (uint8_t) name->Len);
+        if (result == 0) {
+            return (Mem_LenType) table->Lookup[mid];
+        }
+        else if (result < 0) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+    return -1;
+}
+/**
+ * @brief return callback of a type of command
+ *
+ * @param table
+ * @param index index of command
+ * @param typeIndex
+ * @return Cmd_CallbackFn NULL if command have no callback for type
+ */
+Cmd_CallbackFn CmdTable_getCallback(const Cmd_Table* table, Mem_LenType index, uint8_t typeIndex) {
+    uint8_t mask = table->CallbackMasks[index];
+    uint16_t offset = table->CallbackOffsets[index];
+    uint8_t bit;
+
+#if CMD_MULTI_CALLBACK == 0
+    typeIndex = 0;
+#endif
+    bit = (uint8_t) (1 << typeIndex);
+    if ((mask & bit) == 0) {
+        return (Cmd_CallbackFn) NULL;
+    }
+    // count callbacks of lower types
+    mask &= (uint8_t) (bit - 1);
+    while (mask) {
+        mask &= (uint8_t) (mask - 1);
+        offset++;
+    }
+    return table->Symbols[table->CallbackIds[offset]];
+}
+/**
+ * @brief hash of command name that store in Keys
+ *
+ * @param name
+ * @param len
+ * @return uint8_t
+ */
+uint8_t CmdTable_hash(const char* name, Str_LenType len) {
+    uint16_t hash = (uint16_t) len;
+
+    while (len-- > 0) {
+        hash = (uint16_t) ((hash << 5) + hash + (uint8_t) *name++);
+    }
+    return (uint8_t) (hash ^ (hash >> 8));
+}
+static Mem_CmpResult CmdTable_compare(const Cmd_Table* table, uint16_t index, uint8_t key, const char* name, uint8_t len) {
+    if (table->Keys[index] != key) {
+        return table->Keys[index] < key ? -1 : 1;
+    }
+    if (table->NameLens[index] != len) {
+        return table->NameLens[index] < len ? -1 : 1;
+    }
+    return Mem_compare(&table->Names[table->NameOffsets[index]], name, len);
+}
+static void CmdTable_count(Cmd_Array* cmds, Cmd_LenType len, uint32_t* callbacks, uint32_t* names) {
+    Cmd_LenType index;
+    uint8_t typeIndex;
+
+    *callbacks = 0;
+    *names = 0;
+    for (index = 0; index < len; index++) {
+        Cmd* cmd = CmdList_get(cmds, index);
+        *names += (uint32_t) cmd->CmdName.Len;
+        for (typeIndex = 0; typeIndex < __CALLBACKS_LEN; typeIndex++) {
+            if (Cmd_getCallback(cmd, typeIndex) != NULL) {
+                (*callbacks)++;
+            }
+        }
+    }
+}
+#endif // CMD_TABLE
+#if CMD_INDEX
+/**
+ * @brief return number of nodes that enough for index of commands
+ *
+ * @param cmds
+ * @param len
+ * @return uint16_t
+ */
+uint16_t CmdManager_indexSize(Cmd_Array* cmds, Cmd_LenType len) {
+    uint32_t size = 1;
+    Cmd_LenType index;
+
+    for (index = 0; index < len; index++) {
+        size += CmdList_get(cmds, index)->CmdName.Len;
+    }
+    return size > 0xFFFF ? 0xFFFF : (uint16_t) size;
+}
+/**
+ * @brief set memory of index and build it for current commands
+ *
+ * @param manager
+ * @param nodes get size from CmdManager_indexSize
+ * @param size
+ * @param order must have space for all commands, include next versions of registry or table
+ * @return uint8_t 1 if index build
+ */
+uint8_t CmdManager_setIndex(CmdManager* manager, Cmd_IndexNode* nodes, uint16_t size, Cmd_LenType* order) {
+    manager->Index.Nodes = nodes;
+    manager->Index.Order = order;
+    manager->Index.Size = size;
+    return CmdManager_buildIndex(manager);
+}
+/**
+ * @brief build index of commands, call it after change names of commands,
+ * change of list, table or registry version detect and rebuild automatically,
+ * in table mode only tables with Cmds can index
+ *
+ * @param manager
+ * @return uint8_t 1 if index build, 0 if nodes not enough or no index memory
+ */
+uint8_t CmdManager_buildIndex(CmdManager* manager) {
+    uint8_t result;
+
+    __enter(manager);
+    result = CmdIndex_build(manager);
+    __leave(manager);
+    return result;
+}
+/**
+ * @brief build index from commands of manager, registry must pinned
+ *
+ * @param manager
+ * @return uint8_t
+ */
+static uint8_t CmdIndex_build(CmdManager* manager) {
+    Cmd_Index* index = &manager->Index;
+    Cmd_IndexNode* nodes = index->Nodes;
+    Cmd_LenType* order = index->Order;
+    Cmd_List* list = &index->List;
+    Cmd_LenType pos;
+    Cmd_LenType next;
+
+    index->Len = 0;
+    CmdIndex_source(manager, list);
+    if (nodes == NULL || index->Size == 0) {
+        return 0;
+    }
+    // sort commands by name, insertion sort keep list untouched
+    for (pos = 0; pos < list->Len; pos++) {
+        Cmd* cmd = CmdList_get(list->Cmds, pos);
+        next = pos;
+        while (next > 0 && CmdIndex_compare(CmdList_get(list->Cmds, order[next - 1]), cmd) > 0) {
+            order[next] = order[next - 1];
+            next--;
+        }
+        order[next] = pos;
+    }
+    // root
+    nodes[0].Child = 0;
+    nodes[0].Next = 0;
+    nodes[0].Start = 0;
+    nodes[0].End = list->Len;
+    nodes[0].Char = '\0';
+    nodes[0].Terminal = 0;
+    index->Len = 1;
+    // names are sorted, so new child always append after last child
+    for (pos = 0; pos < list->Len; pos++) {
+        Cmd* cmd = CmdList_get(list->Cmds, order[pos]);
+        uint16_t node = 0;
+        Str_LenType charIndex;
+
+        for (charIndex = 0; charIndex < cmd->CmdName.Len; charIndex++) {
+            char c = cmd->CmdName.Text[charIndex];
+            uint16_t child = CmdIndex_find(index, node, c);
+            if (child == 0) {
+                uint16_t last = nodes[node].Child;
+                if (index->Len == index->Size) {
+                    index->Len = 0;
+                    return 0;
+                }
+                child = index->Len++;
+                nodes[child].Child = 0;
+                nodes[child].Next = 0;
+                nodes[child].Start = pos;
+                nodes[child].Char = c;
+                nodes[child].Terminal = 0;
+                if (last == 0) {
+                    nodes[node].Child = child;
+                }
+                else {
+                    while (nodes[last].Next != 0) {
+                        last = nodes[last].Next;
+                    }
+                    nodes[last].Next = child;
+                }
+            }
+            nodes[child].End = pos + 1;
+            node = child;
+        }
+        // shorter name sort first, so Start of node is this command
+        if (node != 0 && !nodes[node].Terminal) {
+            nodes[node].Terminal = 1;
+        }
+    }
+    return 1;
+}
+/**
+ * @brief find commands that start with prefix, in order of name
+ *
+ * @param manager
+ * @param prefix
+ * @param len
+ * @param result
+ * @param max size of result
+ * @return Cmd_LenType number of all completions, can be more than max
+ */
+Cmd_LenType CmdManager_complete(CmdManager* manager, const char* prefix, Str_LenType len, Cmd** result, Cmd_LenType max) {
+    Cmd_LenType count = 0;
+
+    __enter(manager);
+    if (CmdIndex_check(manager)) {
+        count = CmdIndex_complete(&manager->Index, prefix, len, result, max);
+    }
+    __leave(manager);
+    return count;
+}
+/**
+ * @brief find commands with name in edit distance of given name, best matches first,
+ * can use in notFound callback, name len is Str_ignoreNameCharacters(str) - str
+ *
+ * @param manager
+ * @param name
+ * @param len
+ * @param maxDistance max number of insert, delete or replace
+ * @param result
+ * @param max size of result
+ * @return Cmd_LenType number of suggestions in result
+ */
+Cmd_LenType CmdManager_suggest(CmdManager* manager, const char* name, Str_LenType len, uint8_t maxDistance, Cmd_Suggestion* result, Cmd_LenType max) {
+    Cmd_LenType count = 0;
+
+    __enter(manager);
+    if (CmdIndex_check(manager)) {
+        count = CmdIndex_suggest(&manager->Index, name, len, maxDistance, result, max);
+    }
+    __leave(manager);
+    return count;
+}
+
+static void CmdIndex_source(CmdManager* manager, Cmd_List* list) {
+#if CMD_TABLE
+    if (manager->Table != NULL) {
+        // names of table without Cmds can not return as Cmd
+        list->Cmds = manager->Table->Cmds;
+        list->Len = manager->Table->Cmds ? manager->Table->Len : 0;
+        return;
+    }
+#endif // CMD_TABLE
+    *list = manager->List;
+}
+static uint8_t CmdIndex_check(CmdManager* manager) {
+    Cmd_Index* index = &manager->Index;
+    Cmd_List list;
+
+    if (index->Nodes == NULL) {
+        return 0;
+    }
+    CmdIndex_source(manager, &list);
+    if (list.Cmds != index->List.Cmds || list.Len != index->List.Len) {
+        CmdIndex_build(manager);
+    }
+    return index->Len != 0;
+}
+static Cmd_LenType CmdIndex_complete(Cmd_Index* index, const char* prefix, Str_LenType len, Cmd** result, Cmd_LenType max) {
+    uint16_t node = 0;
+    Cmd_LenType pos;
+
+    while (len-- > 0) {
+        node = CmdIndex_find(index, node, CmdIndex_convert(*prefix++));
+        if (node == 0) {
+            return 0;
+        }
+    }
+    for (pos = index->Nodes[node].Start; pos < index->Nodes[node].End && max > 0; pos++, max--) {
+        *result++ = CmdList_get(index->List.Cmds, index->Order[pos]);
+    }
+    return index->Nodes[node].End - index->Nodes[node].Start;
+}
+static Cmd_LenType CmdIndex_suggest(Cmd_Index* index, const char* name, Str_LenType len, uint8_t maxDistance, Cmd_Suggestion* result, Cmd_LenType max) {
+    uint8_t rows[CMD_INDEX_NAME_MAX + 1][CMD_INDEX_NAME_MAX + 1];
+    uint16_t path[CMD_INDEX_NAME_MAX + 1];
+    char input[CMD_INDEX_NAME_MAX];
+    Cmd_IndexNode* nodes = index->Nodes;
+    Cmd_LenType count = 0;
+    uint16_t node;
+    uint8_t maxDepth;
+    uint8_t depth;
+    uint8_t col;
+
+    if (len > CMD_INDEX_NAME_MAX || max == 0) {
+        return 0;
+    }
+    for (col = 0; col <= len; col++) {
+        rows[0][col] = col;
+        if (col < len) {
+            input[col] = CmdIndex_convert(name[col]);
+        }
+    }
+    // longer names can not be in distance
+    maxDepth = (uint8_t) __min((uint16_t) len + maxDistance, CMD_INDEX_NAME_MAX);
+    depth = 1;
+    node = nodes[0].Child;
+    while (depth > 0) {
+        uint8_t* prev;
+        uint8_t* row;
+        uint8_t rowMin;
+
+        if (node == 0) {
+            // back to sibling of parent
+            depth--;
+            node = depth > 0 ? nodes[path[depth]].Next : 0;
+            continue;
+        }
+        path[depth] = node;
+        prev = rows[depth - 1];
+        row = rows[depth];
+        row[0] = depth;
+        rowMin = depth;
+        for (col = 1; col <= len; col++) {
+            uint8_t cost = prev[col - 1] + (input[col - 1] != nodes[node].Char);
+            cost = __min(cost, prev[col] + 1);
+            cost = __min(cost, row[col - 1] + 1);
+            row[col] = cost;
+            rowMin = __min(rowMin, cost);
+        }
+        if (nodes[node].Terminal && row[len] <= maxDistance) {
+            count = CmdIndex_insert(result, count, max, CmdList_get(index->List.Cmds, index->Order[nodes[node].Start]), row[len]);
+        }
+        if (rowMin <= maxDistance && nodes[node].Child != 0 && depth < maxDepth) {
+            depth++;
+            node = nodes[node].Child;
+        }
+        else {
+            node = nodes[node].Next;
+        }
+    }
+    return count;
+}
+
+static Mem_CmpResult CmdIndex_compare(Cmd* a, Cmd* b) {
+    Mem_LenType len = __min(a->CmdName.Len, b->CmdName.Len);
+    Mem_CmpResult result = Mem_compare(a->CmdName.Text, b->CmdName.Text, len);
+
+    if (result == 0) {
+        result = (Mem_CmpResult) a->CmdName.Len - (Mem_CmpResult) b->CmdName.Len;
+    }
+    return result;
+}
+static char CmdIndex_convert(char c) {
+#if CMD_CASE_MODE == CMD_CASE_INSENSITIVE
+    #if CMD_NAME_MODE == CMD_LOWER_CASE
+        if (c >= 'A' && c <= 'Z') {
+            c += 'a' - 'A';
+        }
+    #else
+        if (c >= 'a' && c <= 'z') {
+            c -= 'a' - 'A';
+        }
+    #endif // CMD_NAME_MODE
+#endif // CMD_CASE_MODE
+    return c;
+}
+static uint16_t CmdIndex_find(Cmd_Index* index, uint16_t node, char c) {
+    node = index->Nodes[node].Child;
+    // children sorted by character
+    while (node != 0 && (uint8_t) index->Nodes[node].Char < (uint8_t) c) {
+        node = index->Nodes[node].Next;
+    }
+    return node != 0 && index->Nodes[node].Char == c ? node : 0;
+}
+static Cmd_LenType CmdIndex_insert(Cmd_Suggestion* result, Cmd_LenType len, Cmd_LenType max, Cmd* cmd, uint8_t distance) {
+    Cmd_LenType pos = len < max ? len : max;
+
+    // keep best suggestions, same distances keep order of names
+    while (pos > 0 && result[pos - 1].Distance > distance) {
+        if (pos < max) {
+            result[pos] = result[pos - 1];
+        }
+        pos--;
+    }
+    if (pos < max) {
+        result[pos].Cmd = cmd;
+        result[pos].Distance = distance;
+    }
+    return len < max ? len + 1 : max;
+}
+#endif // CMD_INDEX
+#if CMD_PREPARED
+/**
+ * @brief resolve command string once, StartWith, name, type and callback,
+ * commands table or list must not change while prepared in use, with registry prepare again after publish
+ *
+ * @param manager
+ * @param prepared
+ * @param line command string without EndWith, ex: "pwm=1,50,0"
+ * @param len
+ * @return uint8_t 1 if command prepared, 0 if not found, not support type or too long
+ */
+uint8_t CmdManager_prepare(CmdManager* manager, Cmd_Prepared* prepared, const char* line, Str_LenType len) {
+    Cmd_HeadResult result;
+    Cmd_Head head;
+
+    if (len >= CMD_PREPARED_SIZE) {
+        return 0;
+    }
+    // parse in place of params, then keep only params
+    Mem_copy(prepared->Params, line, len);
+    prepared->Params[len] = '\0';
+    __enter(manager);
+    result = CmdManager_parseHead(manager, prepared->Params, len, &head);
+#if CMD_CACHE || CMD_AUDIT || CMD_RATE_LIMIT
+    if (result == Cmd_HeadResult_Found) {
+    #if CMD_CACHE || CMD_RATE_LIMIT
+        // key read from pinned commands
+        prepared->Key = CmdManager_key(manager, head.Index);
+    #endif
+        prepared->Index = head.Index;
+    }
+#endif
+#if CMD_RCU
+    prepared->Version = manager->Registry != NULL ? manager->Registry->Slots[manager->Slot].Version : 0;
+#endif
+    __leave(manager);
+    if (result != Cmd_HeadResult_Found || head.Fn == NULL) {
+        return 0;
+    }
+    prepared->Cmd = head.Cmd;
+    prepared->Fn = head.Fn;
+    prepared->Type = head.TypeIndex != -1 ? (Cmd_Type) (1 << head.TypeIndex) : Cmd_Type_None;
+    prepared->CallbackIndex = head.CallbackIndex;
+    return CmdPrepared_bind(prepared, head.Params, (Str_LenType) (&prepared->Params[len] - head.Params));
+}
+/**
+ * @brief call callback of prepared command with its params, same as process of line
+ * command shed by limits and not run while a multi line command in use
+ *
+ * @param manager
+ * @param prepared
+ * @param cursor
+ * @return Cmd_Handled result of callback, Cmd_Error if not run or registry publish new version after prepare
+ */
+Cmd_Handled CmdManager_execute(CmdManager* manager, Cmd_Prepared* prepared, Param_Cursor* cursor) {
+    Cmd_Handled handled = Cmd_Error;
+
+    __enter(manager);
+#if CMD_RCU
+    // commands of previous version may reclaimed, prepare again after publish
+    if (manager->Registry == NULL || manager->Registry->Slots[manager->Slot].Version == prepared->Version)
+#endif
+    {
+        handled = CmdManager_run(manager, prepared, cursor);
+    }
+    __leave(manager);
+    return handled;
+}
+/**
+ * @brief check prepared command can run and call its callback
+ *
+ * @param manager
+ * @param prepared
+ * @param cursor
+ * @return Cmd_Handled
+ */
+static Cmd_Handled CmdManager_run(CmdManager* manager, Cmd_Prepared* prepared, Param_Cursor* cursor) {
+    char params[CMD_PREPARED_SIZE];
+    Cmd_Handled handled;
+#if CMD_CACHE && CMD_TYPE_SET
+    Cmd_CacheEntry* entry;
+#endif
+#if CMD_AUDIT
+    Cmd_Head head;
+
+    head.Index = prepared->Index;
+    head.TypeIndex = prepared->Type != Cmd_Type_None ? prepared->CallbackIndex : -1;
+#endif
+    // next input belong to multi line command
+    if (manager->InUseFn != NULL) {
+        return Cmd_Error;
+    }
+#if CMD_RATE_LIMIT
+    {
+        Cmd_Limit* limit = CmdManager_limit(manager, prepared->Index, prepared->Key);
+
+        if (!CmdManager_admit(manager, &manager->Limit, NULL, prepared->Params) ||
+            (limit != NULL && !CmdManager_admit(manager, limit, prepared->Cmd, prepared->Params))) {
+        #if CMD_AUDIT
+            CmdManager_audit(manager, prepared->Params, prepared->Len, &head, Cmd_Result_Shed);
+        #endif
+            return Cmd_Error;
+        }
+    }
+#endif // CMD_RATE_LIMIT
+    // callbacks can modify params while parsing
+    Mem_copy(params, prepared->Params, prepared->Len + 1);
+    cursor->Ptr = params;
+    cursor->Len = prepared->Len;
+    cursor->ParamSeparator = manager->ParamSeparator;
+    cursor->Index = 0;
+    handled = prepared->Fn(manager, prepared->Cmd, cursor, prepared->Type);
+#if CMD_CACHE && CMD_TYPE_SET
+    if (prepared->Type == Cmd_Type_Set && handled != Cmd_Error) {
+        entry = CmdManager_cacheEntry(manager, prepared->Index, prepared->Key);
+        if (entry != NULL) {
+            entry->Valid = 0;
+        }
+    }
+#endif
+#if CMD_AUDIT
+    // prepared commands keep only params
+    CmdManager_audit(manager, prepared->Params, prepared->Len, &head, handled == Cmd_Error ? Cmd_Result_Error : Cmd_Result_Done);
+#endif
+    if (handled == Cmd_Continue) {
+        manager->InUseCmd = prepared->Cmd;
+        manager->InUseFn = prepared->Fn;
+        manager->InUseCmdTypeIndex = prepared->CallbackIndex;
+    }
+    return handled;
+}
+/**
+ * @brief change params of prepared command
+ *
+ * @param prepared
+ * @param params new params, ex: "1,60,0"
+ * @param len
+ * @return uint8_t 1 if params fit in prepared
+ */
+uint8_t CmdPrepared_bind(Cmd_Prepared* prepared, const char* params, Str_LenType len) {
+    if (len >= CMD_PREPARED_SIZE || (params < prepared->Params && params + len > prepared->Params)) {
+        return 0;
+    }
+    // params can be after start of prepared buffer, forward copy is safe
+    for (prepared->Len = 0; prepared->Len < len; prepared->Len++) {
+        prepared->Params[prepared->Len] = params[prepared->Len];
+    }
+    prepared->Params[len] = '\0';
+    return 1;
+}
+#endif // CMD_PREPARED
+#if CMD_RATE_LIMIT
+/**
+ * @brief refill bucket based on elapsed ticks and take a token
+ *
+ * @param limit
+ * @param ticks current ticks
+ * @return uint8_t 1 if token taken
+ */
+static uint8_t CmdLimit_take(Cmd_Limit* limit, uint32_t ticks) {
+    uint32_t tokens;
+
+    if (limit->Burst == 0) {
+        return 1;
+    }
+    if (limit->Period != 0) {
+        tokens = (ticks - limit->Last) / limit->Period;
+        if (tokens >= (uint32_t) (limit->Burst - limit->Tokens)) {
+            limit->Tokens = limit->Burst;
+            limit->Last = ticks;
+        }
+        else if (tokens != 0) {
+            limit->Tokens += (uint16_t) tokens;
+            limit->Last += tokens * limit->Period;
+        }
+    }
+    if (limit->Tokens == 0) {
+        limit->Shed++;
+        return 0;
+    }
+    limit->Tokens--;
+    return 1;
+}
+/**
+ * @brief check limit and call overload if shed
+ *
+ * @param manager
+ * @param limit
+ * @param cmd NULL for limit of lines
+ * @param str shed line or statement
+ * @return uint8_t 1 if admitted
+ */
+static uint8_t CmdManager_admit(CmdManager* manager, Cmd_Limit* limit, Cmd* cmd, char* str) {
+    if (CmdLimit_take(limit, manager->Ticks)) {
+        return 1;
+    }
+    manager->Stats.Shed++;
+    if (manager->overload) {
+        manager->overload(manager, cmd, str);
+    }
+    return 0;
+}
+/**
+ * @brief return limit of command if it set for same command
+ *
+ * @param manager
+ * @param index index of command
+ * @param key key of command
+ * @return Cmd_Limit* NULL if limits disabled, index out of limits or limit belong to other command
+ */
+static Cmd_Limit* CmdManager_limit(CmdManager* manager, Mem_LenType index, const void* key) {
+    Cmd_Limit* limit;
+
+    if (manager->Limits == NULL || index >= (Mem_LenType) manager->LimitsLen) {
+        return NULL;
+    }
+    limit = &manager->Limits[index];
+    return limit->Key == key ? limit : NULL;
+}
+#endif // CMD_RATE_LIMIT
+#if CMD_AUDIT
+/**
+ * @brief pass result of command to audit callback
+ *
+ * @param manager
+ * @param line first bytes of statement
+ * @param len
+ * @param head resolved head, NULL if not found
+ * @param result
+ */
+static void CmdManager_audit(CmdManager* manager, const char* line, Str_LenType len, Cmd_Head* head, Cmd_Result result) {
+    Cmd_AuditEvent event;
+
+    if (manager->audit == NULL) {
+        return;
+    }
+    event.Line = line;
+    event.Len = __min(len, CMD_AUDIT_LINE_MAX);
+    event.Index = head != NULL ? head->Index : -1;
+    event.Type = head != NULL && head->TypeIndex != -1 ? (uint8_t) (1 << head->TypeIndex) : (uint8_t) Cmd_Type_None;
+    event.Result = (uint8_t) result;
+    manager->audit(manager, manager->AuditArgs, &event);
+}
+#endif // CMD_AUDIT
@@ -31,11 +31,15 @@ extern "C" {
 /**
  * @brief enable multi callback, when you want callback per Cmd_Type
  */
+#ifndef CMD_MULTI_CALLBACK
 #define CMD_MULTI_CALLBACK                  1
+#endif
 /**
  * @brief enable sort Cmd_Array on init or setCmds
  */
+#ifndef CMD_SORT_LIST
 #define CMD_SORT_LIST                       0
+#endif
 
 #if CMD_SORT_LIST
     #define CMD_SORT_ALG_SELECTION          1
@@ -43,7 +47,9 @@ extern "C" {
     /**
      * @brief set what algorithm used for sort commands
      */
+    #ifndef CMD_SORT_ALG
     #define CMD_SORT_ALG                    CMD_SORT_ALG_SELECTION
+    #endif
 #endif // CMD_SORT_LIST
 
 
@@ -52,28 +58,160 @@ extern "C" {
 /**
  * @brief check commands and some value in case-sensitive mode or insensitive
  */
+#ifndef CMD_CASE_MODE
 #define CMD_CASE_MODE                       CMD_CASE_INSENSITIVE
+#endif
 #if CMD_CASE_MODE == CMD_CASE_INSENSITIVE
     #define CMD_LOWER_CASE                  1
     #define CMD_UPPER_CASE                  2
     /**
      * @brief convert cmd name and some value into which mode before process
      */
+    #ifndef CMD_NAME_MODE
     #define CMD_NAME_MODE                   CMD_LOWER_CASE
+    #endif
     /**
      * @brief convert start with in case-insensitive
      */
+    #ifndef CMD_CONVERT_START_WITH
     #define CMD_CONVERT_START_WITH          0
+    #endif
 #endif // CMD_CASE_MOE
 /**
  * @brief remove backspace characters before process
  */
+#ifndef CMD_REMOVE_BACKSPACE
 #define CMD_REMOVE_BACKSPACE                1
+#endif
+/**
+ * @brief enable bounded mode for hard real time, lines and names longer than limits
+ * reject before scan, name compare limit to CMD_NAME_MAX_LEN + 1 bytes,
+ * need CMD_SORT_LIST for binary search, tables only search with Lookup
+ */
+#ifndef CMD_BOUNDED
+#define CMD_BOUNDED                         0
+#endif
+#if CMD_BOUNDED
+    /**
+     * @brief max length of command name, longer names pass to notFound
+     */
+    #ifndef CMD_NAME_MAX_LEN
+    #define CMD_NAME_MAX_LEN                16
+    #endif
+    /**
+     * @brief max length of line, longer lines pass to bufferOverflow
+     */
+    #ifndef CMD_LINE_MAX_LEN
+    #define CMD_LINE_MAX_LEN                64
+    #endif
+#endif // CMD_BOUNDED
+/**
+ * @brief enable single pass tokenizer with character class table, it remove backspaces,
+ * ignore whitespaces, find name with case conversion and find type in one loop
+ */
+#ifndef CMD_CHAR_CLASS
+#define CMD_CHAR_CLASS                      0
+#endif
+
+/**
+ * @brief enable multiple commands in single line, ex: "led=1;pwm=50;save"
+ */
+#ifndef CMD_STATEMENT
+#define CMD_STATEMENT                       0
+#endif
+/**
+ * @brief enable skip Set commands that overwrite by next Set of same command in a batch
+ * commands need Cmd_Option_Coalesce or Cmd_Option_CoalesceKey option,
+ * batch is statements of a line or lines of CmdManager_handleBatch, need CMD_STATEMENT or CMD_PRIORITY,
+ * statements between two Sets must not stop the batch, so StopOnError keep Sets that not adjacent,
+ * without CMD_MULTILINE any command between them may take next statements
+ */
+#ifndef CMD_COALESCE
+#define CMD_COALESCE                        0
+#endif
+/**
+ * @brief max number of statements that split and resolve together
+ */
+#ifndef CMD_BATCH_SIZE
+#define CMD_BATCH_SIZE                      8
+#endif
+/**
+ * @brief enable Cmd_Option_Multiline, mark commands that may return Cmd_Continue
+ * and read next lines, CmdScript run scripts that have them sequentially
+ */
+#ifndef CMD_MULTILINE
+#define CMD_MULTILINE                       0
+#endif
+/**
+ * @brief enable prepared commands, resolve a command string once and execute it many times
+ */
+#ifndef CMD_PREPARED
+#define CMD_PREPARED                        0
+#endif
+#if CMD_PREPARED
+    /**
+     * @brief max length of prepared command string
+     */
+    #ifndef CMD_PREPARED_SIZE
+    #define CMD_PREPARED_SIZE               32
+    #endif
+#endif // CMD_PREPARED
+
+/**
+ * @brief enable capture hook, pass raw bytes that read from input to a callback
+ * before process, useful for record traffic and replay it later, see CmdCapture
+ */
+#ifndef CMD_CAPTURE
+#define CMD_CAPTURE                         0
+#endif
+#if CMD_CAPTURE
+    /**
+     * @brief max bytes of line with EndWith that CmdManager_captureLine pass as single record,
+     * default fit CmdIpc lines with "\r\n"
+     */
+    #ifndef CMD_CAPTURE_LINE_MAX
+    #define CMD_CAPTURE_LINE_MAX            258
+    #endif
+#endif // CMD_CAPTURE
+
+/**
+ * @brief enable token bucket rate limit for manager and each command, lines over
+ * manager limit shed before lookup, commands over own limit shed before callback
+ */
+#ifndef CMD_RATE_LIMIT
+#define CMD_RATE_LIMIT                      0
+#endif
+
+/**
+ * @brief enable cache of Get responses for each command, responses that write with
+ * CmdManager_respond keep until TTL expire or a Set on same command, need CMD_TYPE_GET
+ */
+#ifndef CMD_CACHE
+#define CMD_CACHE                           0
+#endif
+
+/**
+ * @brief enable audit hook, pass result of each command with first bytes of it's statement
+ * to a callback after process, see CmdAudit
+ */
+#ifndef CMD_AUDIT
+#define CMD_AUDIT                           0
+#endif
+#if CMD_AUDIT
+    /**
+     * @brief max bytes of statement that pass to audit callback
+     */
+    #ifndef CMD_AUDIT_LINE_MAX
+    #define CMD_AUDIT_LINE_MAX              64
+    #endif
+#endif // CMD_AUDIT
 
 /**
  * @brief enable CmdManager have args
  */
+#ifndef CMD_MANAGER_ARGS
 #define CMD_MANAGER_ARGS                    1
+#endif
 
 /**
  * @brief define type of Cmd array len, based on max len of Cmd_Array
@@ -85,41 +223,126 @@ typedef uint8_t Cmd_LenType;
 /**
  * @brief define type of cmd array, CMD_LIST_POINTER_ARRAY, is faster on sorting
  */
+#ifndef CMD_LIST_MODE
 #define CMD_LIST_MODE                       CMD_LIST_POINTER_ARRAY
+#endif
+/**
+ * @brief enable Cmd_Table, compiled struct of arrays layout of commands,
+ * binary search only touch hash keys and name lengths, callbacks store in sparse table
+ */
+#ifndef CMD_TABLE
+#define CMD_TABLE                           0
+#endif
+/**
+ * @brief enable Cmd_Registry, commands can replace while other threads process lines,
+ * readers pin a version for each dispatch without lock, need GCC atomic builtins
+ */
+#ifndef CMD_RCU
+#define CMD_RCU                             0
+#endif
+#if CMD_RCU
+    /**
+     * @brief call while publisher wait for readers, ex: sched_yield() on hosts
+     */
+    #ifndef CMD_RCU_YIELD
+    #define CMD_RCU_YIELD()
+    #endif
+#endif // CMD_RCU
+/**
+ * @brief enable trie index of command names for completion and suggestion,
+ * index rebuild on CmdManager_setCommands
+ */
+#ifndef CMD_INDEX
+#define CMD_INDEX                           0
+#endif
+#if CMD_INDEX
+    /**
+     * @brief max length of name that CmdManager_suggest accept
+     */
+    #ifndef CMD_INDEX_NAME_MAX
+    #define CMD_INDEX_NAME_MAX              32
+    #endif
+#endif // CMD_INDEX
 /**
  * @brief temp buffer size in CmdManager_handle
  */
+#ifndef CMD_HANDLE_BUFFER_SIZE
 #define CMD_HANDLE_BUFFER_SIZE              48
+#endif
 /**
  * @brief enable cmd type for execute
  */
+#ifndef CMD_TYPE_EXE
 #define CMD_TYPE_EXE                        1
+#endif
 /**
  * @brief enable cmd type for set
  */
+#ifndef CMD_TYPE_SET
 #define CMD_TYPE_SET                        1
+#endif
 /**
  * @brief enable cmd type for get
  */
+#ifndef CMD_TYPE_GET
 #define CMD_TYPE_GET                        1
+#endif
 /**
  * @brief enable cmd type for help
  */
+#ifndef CMD_TYPE_HELP
 #define CMD_TYPE_HELP                       1
+#endif
 /**
  * @brief enable cmd type for response
  */
+#ifndef CMD_TYPE_RESP
 #define CMD_TYPE_RESP                       1
+#endif
 /**
  * @brief enable cmd type for unknown
  */
+#ifndef CMD_TYPE_UNKNOWN
 #define CMD_TYPE_UNKNOWN                    1
+#endif
 /**
  * @brief enable use InputStream library
  */
+#ifndef CMD_STREAM
 #define CMD_STREAM                          1
+#endif
 #if CMD_STREAM
     #include "InputStream.h"
+    /**
+     * @brief enable stream params of commands that longer than handle buffer in multiple chunks
+     * commands need Cmd_Option_Chunked option, other long commands drop as overflow
+     */
+    #ifndef CMD_CHUNK
+    #define CMD_CHUNK                       0
+    #endif
+    /**
+     * @brief enable CmdManager_handleBatch, run commands with Cmd_Option_Priority
+     * of pending lines before others, need IStream_findPatternAt and IStream_getBytesAt,
+     * lines before a priority line must not take next lines, so without CMD_MULTILINE
+     * only priority lines at head of stream run first
+     */
+    #ifndef CMD_PRIORITY
+    #define CMD_PRIORITY                    0
+    #endif
+    #if CMD_PRIORITY
+        /**
+         * @brief max number of pending lines that scan in each CmdManager_handleBatch,
+         * also max number of priority lines that run before lines ahead of them
+         */
+        #ifndef CMD_PRIORITY_LINES
+        #define CMD_PRIORITY_LINES          16
+        #endif
+    #endif // CMD_PRIORITY
+#else
+    #undef CMD_CHUNK
+    #define CMD_CHUNK                       0
+    #undef CMD_PRIORITY
+    #define CMD_PRIORITY                    0
 #endif
 
 /**
@@ -134,6 +357,7 @@ typedef StrConst Cmd_Str;
 #define CMD_DEFAULT_PATTERN_TYPE_RESP       ":"
 #define CMD_DEFAULT_END_WITH                "\n"
 #define CMD_DEFAULT_PARAM_SEPARATOR         ','
+#define CMD_DEFAULT_STATEMENT_SEPARATOR     ';'
 /********************************************************************************/
 
 /* pre-define types */
@@ -203,12 +427,55 @@ typedef enum {
     Cmd_Type_Any            = 0x1F,                         /**< check all types */
 } Cmd_Type;
 
+/**
+ * @brief define number of enable options
+ */
+#define CMD_OPTIONS                 (CMD_CHUNK || CMD_COALESCE || CMD_PRIORITY || CMD_MULTILINE)
+/**
+ * @brief define manager have counters or not
+ */
+#define CMD_STATS                   (CMD_COALESCE || CMD_RATE_LIMIT || CMD_CACHE)
+/**
+ * @brief define manager have ticks or not
+ */
+#define CMD_TICKS                   (CMD_RATE_LIMIT || CMD_CACHE)
+/**
+ * @brief options of command
+ */
+typedef enum {
+    Cmd_Option_None         = 0x00,
+#if CMD_CHUNK
+    Cmd_Option_Chunked      = 0x01,                         /**< receive long params in multiple chunks */
+#endif
+#if CMD_COALESCE
+    Cmd_Option_Coalesce     = 0x02,                         /**< only last Set of a batch call */
+    Cmd_Option_CoalesceKey  = 0x04,                         /**< only last Set with same first param of a batch call */
+#endif
+#if CMD_PRIORITY
+    Cmd_Option_Priority     = 0x08,                         /**< run before other commands of a batch */
+#endif
+#if CMD_MULTILINE
+    Cmd_Option_Multiline    = 0x10,                         /**< may return Cmd_Continue and read next lines */
+#endif
+} Cmd_Option;
+#if CMD_CHUNK
+/**
+ * @brief show which part of params passed to callback
+ */
+typedef enum {
+    Cmd_Chunk_None          = 0x00,
+    Cmd_Chunk_First         = 0x01,     /**< first chunk, cmd and type resolved from it */
+    Cmd_Chunk_Last          = 0x02,     /**< last chunk, EndWith received */
+    Cmd_Chunk_Whole         = 0x03,     /**< whole params in single call */
+} Cmd_Chunk;
+#endif // CMD_CHUNK
 /**
  * @brief determine need handle multiple ending or not
  */
 typedef enum {
     Cmd_Done                = 0,        /**< command end with single ending */
     Cmd_Continue            = 1,        /**< command have multiple ending */
+    Cmd_Error               = 2,        /**< command failed, same as Cmd_Done for multiple ending */
 } Cmd_Handled;
 /**
  * @brief callback of command
@@ -216,6 +483,37 @@ typedef enum {
 typedef Cmd_Handled (*Cmd_CallbackFn) (CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type);
 typedef void (*Cmd_NotFoundFn) (CmdManager* manager, char* str);
 typedef void (*Cmd_OverflowFn) (CmdManager* manager);
+typedef void (*Cmd_CaptureFn) (CmdManager* manager, void* args, const char* data, Str_LenType len);
+/**
+ * @brief call when line or command shed, cmd is NULL when line shed by manager limit
+ */
+typedef void (*Cmd_OverloadFn) (CmdManager* manager, Cmd* cmd, char* str);
+/**
+ * @brief write response of command to output
+ */
+typedef void (*Cmd_RespondFn) (CmdManager* manager, const char* data, Str_LenType len);
+#if CMD_AUDIT
+/**
+ * @brief result of command in audit event
+ */
+typedef enum {
+    Cmd_AuditResult_Done        = 0,    /**< callback return Cmd_Done or Cmd_Continue */
+    Cmd_AuditResult_NotFound    = 1,    /**< cmd or type not found */
+    Cmd_AuditResult_Error       = 2,    /**< callback return Cmd_Error */
+    Cmd_AuditResult_Shed        = 3,    /**< shed by rate limit */
+} Cmd_AuditResult;
+/**
+ * @brief audit event of a command, valid only during audit callback
+ */
+typedef struct {
+    const char*     Line;               /**< first CMD_AUDIT_LINE_MAX bytes of statement before process, params for prepared commands */
+    Str_LenType     Len;
+    Mem_LenType     Index;              /**< index of cmd in list or table, -1 if not found */
+    uint8_t         Type;               /**< Cmd_Type of statement, Cmd_Type_None if not found */
+    uint8_t         Result;             /**< Cmd_AuditResult */
+} Cmd_AuditEvent;
+typedef void (*Cmd_AuditFn) (CmdManager* manager, void* args, const Cmd_AuditEvent* event);
+#endif // CMD_AUDIT
 /**
  * @brief hold callback functions
  */
@@ -272,6 +570,51 @@ typedef union {
     #endif
     };
 } Cmd_Types;
+#if CMD_OPTIONS
+/**
+ * @brief hold options of command
+ */
+typedef union {
+    uint8_t         Flags;
+    struct {
+    #if CMD_CHUNK
+        uint8_t     Chunked     : 1;
+    #else
+        uint8_t                 : 1;
+    #endif
+    #if CMD_COALESCE
+        uint8_t     Coalesce    : 1;
+        uint8_t     CoalesceKey : 1;
+    #else
+        uint8_t                 : 2;
+    #endif
+    #if CMD_PRIORITY
+        uint8_t     Priority    : 1;
+    #else
+        uint8_t                 : 1;
+    #endif
+    #if CMD_MULTILINE
+        uint8_t     Multiline   : 1;
+    #endif
+    };
+} Cmd_Options;
+#endif // CMD_OPTIONS
+#if CMD_STATS
+/**
+ * @brief counters of manager
+ */
+typedef struct {
+#if CMD_COALESCE
+    uint32_t        Coalesced;      /**< number of Set commands skipped by newer Set */
+#endif
+#if CMD_RATE_LIMIT
+    uint32_t        Shed;           /**< number of lines and commands shed by limits */
+#endif
+#if CMD_CACHE
+    uint32_t        CacheHits;      /**< number of Get commands served from cache */
+#endif
+} Cmd_Stats;
+#endif // CMD_STATS
 /**
  * @brief custom type pattern
  */
@@ -302,6 +645,9 @@ struct __Cmd {
     Cmd_Callbacks       Callbacks;
     Cmd_Str             CmdName;
     Cmd_Types           Types;
+#if CMD_OPTIONS
+    Cmd_Options         Options;
+#endif
 };
 /**
  * @brief hold array of commands
@@ -310,6 +656,153 @@ typedef struct {
     Cmd_Array*          Cmds;
     Cmd_LenType         Len;
 } Cmd_List;
+#if CMD_TABLE
+/**
+ * @brief compiled commands, each array hold one property of all commands
+ * callback of a type is CallbackIds[CallbackOffsets[i] + number of lower bits in CallbackMasks[i]]
+ * commands keep order of list, Lookup sort them by key, length and name for binary search
+ */
+typedef struct {
+    Cmd_Array*              Cmds;               /**< commands that pass to callbacks, can be NULL */
+    const Cmd_CallbackFn*   Symbols;            /**< unique callbacks */
+    const uint16_t*         NameOffsets;        /**< offset of each name in Names */
+    const uint16_t*         CallbackOffsets;    /**< index of first callback in CallbackIds */
+    const uint16_t*         CallbackIds;        /**< index of callback in Symbols */
+    const uint16_t*         Lookup;             /**< indexes of commands in search order, NULL for linear search */
+    const uint8_t*          Keys;               /**< hash of each name */
+    const uint8_t*          NameLens;
+    const uint8_t*          Types;              /**< Cmd_Types flags */
+    const uint8_t*          CallbackMasks;      /**< bit of each type that have callback */
+#if CMD_OPTIONS
+    const uint8_t*          Options;            /**< Cmd_Options flags */
+#endif
+    const char*             Names;              /**< packed names without null terminator */
+    Cmd_LenType             Len;
+    uint16_t                SymbolsLen;
+} Cmd_Table;
+#endif // CMD_TABLE
+#if CMD_INDEX
+/**
+ * @brief single node of index trie, children of each node sorted by character
+ * commands that start with prefix of node are Order[Start] ~ Order[End - 1]
+ */
+typedef struct {
+    uint16_t                Child;              /**< first child, 0 if no child */
+    uint16_t                Next;               /**< next sibling, 0 if no sibling */
+    Cmd_LenType             Start;
+    Cmd_LenType             End;
+    char                    Char;
+    uint8_t                 Terminal;           /**< name of Order[Start] end at this node */
+} Cmd_IndexNode;
+/**
+ * @brief hold trie index of command names, memory provide by user
+ * index rebuild when commands of manager (list, table or published version) change
+ */
+typedef struct {
+    Cmd_IndexNode*          Nodes;
+    Cmd_LenType*            Order;              /**< commands sorted by name */
+    Cmd_List                List;               /**< commands that index build from */
+    uint16_t                Size;               /**< size of Nodes */
+    uint16_t                Len;                /**< used nodes, 0 if index not valid */
+} Cmd_Index;
+/**
+ * @brief result of CmdManager_suggest
+ */
+typedef struct {
+    Cmd*                    Cmd;
+    uint8_t                 Distance;           /**< edit distance of name */
+} Cmd_Suggestion;
+#endif // CMD_INDEX
+#if CMD_CHAR_CLASS
+/**
+ * @brief class flags of a character
+ */
+typedef enum {
+    Cmd_Char_None           = 0x00,
+    Cmd_Char_Space          = 0x01,             /**< ignore before name and type */
+    Cmd_Char_Name           = 0x02,             /**< part of command name */
+    Cmd_Char_Type           = 0x04,             /**< part of type pattern */
+    Cmd_Char_Backspace      = 0x08,             /**< remove previous character */
+    Cmd_Char_Fold           = 0x10,             /**< toggle case of name character */
+} Cmd_CharType;
+/**
+ * @brief class of each character, '\0' must be Cmd_Char_None
+ */
+typedef struct {
+    uint8_t                 Class[256];
+} Cmd_CharClass;
+#endif // CMD_CHAR_CLASS
+#if CMD_PREPARED
+/**
+ * @brief hold resolved command, params keep as text because callbacks parse them
+ */
+typedef struct {
+    Cmd*                    Cmd;                /**< can be NULL for Cmd_Table without Cmds */
+    Cmd_CallbackFn          Fn;
+    Cmd_Type                Type;               /**< type that pass to callback */
+    uint8_t                 CallbackIndex;
+#if CMD_CACHE || CMD_RATE_LIMIT
+    const void*             Key;                /**< key of cache entry and limit */
+#endif
+#if CMD_CACHE || CMD_AUDIT || CMD_RATE_LIMIT
+    Mem_LenType             Index;              /**< index of cmd in list or table */
+#endif
+#if CMD_RCU
+    uint32_t                Version;            /**< version of registry that command resolved from */
+#endif
+    Str_LenType             Len;                /**< length of params */
+    char                    Params[CMD_PREPARED_SIZE];
+} Cmd_Prepared;
+#endif // CMD_PREPARED
+#if CMD_RCU
+/**
+ * @brief single version of commands
+ */
+typedef struct {
+    Cmd_List                List;
+#if CMD_TABLE
+    const Cmd_Table*        Table;
+#endif
+    uint32_t                Version;            /**< version that publish in slot */
+} Cmd_RegistrySlot;
+/**
+ * @brief commands that share between managers of multiple threads,
+ * current slot is Version & 1, other slot keep previous version until readers leave it
+ */
+typedef struct {
+    Cmd_RegistrySlot        Slots[2];
+    uint32_t                Readers[2];         /**< number of managers that pin each slot */
+    uint32_t                Version;
+} Cmd_Registry;
+#endif // CMD_RCU
+#if CMD_RATE_LIMIT
+/**
+ * @brief token bucket, each Period ticks add a token until Burst,
+ * each line or command take a token
+ */
+typedef struct {
+    const void*             Key;                /**< command of limit, Cmd or name in table, other commands skip limit */
+    uint32_t                Last;               /**< tick of last refill */
+    uint32_t                Shed;               /**< number of lines or commands shed by this limit */
+    uint16_t                Tokens;
+    uint16_t                Burst;              /**< max tokens, 0 for no limit */
+    uint16_t                Period;             /**< ticks per token, 0 for no refill */
+} Cmd_Limit;
+#endif // CMD_RATE_LIMIT
+#if CMD_CACHE
+/**
+ * @brief cached Get response of a command
+ */
+typedef struct {
+    const void*             Key;                /**< command of entry, Cmd or name in table, other commands skip entry */
+    char*                   Buffer;
+    Str_LenType             Size;
+    Str_LenType             Len;
+    uint32_t                Time;               /**< tick of fill */
+    uint16_t                TTL;                /**< ticks that response is valid, 0 for no cache */
+    uint8_t                 Valid;
+} Cmd_CacheEntry;
+#endif // CMD_CACHE
 /**
  * @brief hold properties of manger that need to handle commands
  */
@@ -322,8 +815,69 @@ struct __CmdManager {
     Cmd_Str*            EndWith;
     Cmd_NotFoundFn      notFound;
     Cmd_OverflowFn      bufferOverflow;
+#if CMD_RATE_LIMIT
+    Cmd_OverloadFn      overload;
+    Cmd_Limit*          Limits;             /**< limit of each command, same order of list or table */
+    Cmd_LenType         LimitsLen;
+    Cmd_Limit           Limit;              /**< limit of lines */
+#endif
+#if CMD_CACHE
+    Cmd_RespondFn       respond;
+    Cmd_CacheEntry*     Cache;              /**< cache of each command, same order of list or table */
+    Cmd_LenType         CacheLen;
+    Cmd_CacheEntry*     Recording;          /**< entry that fill by current Get */
+#endif
+#if CMD_TICKS
+    uint32_t            Ticks;
+#endif
+#if CMD_CAPTURE
+    Cmd_CaptureFn       capture;
+    void*               CaptureArgs;
+#endif
+#if CMD_AUDIT
+    Cmd_AuditFn         audit;
+    void*               AuditArgs;
+#endif
     Cmd*                InUseCmd;
+    Cmd_CallbackFn      InUseFn;
     Cmd_List            List;
+#if CMD_TABLE
+    const Cmd_Table*    Table;
+#endif
+#if CMD_INDEX
+    Cmd_Index           Index;
+#endif
+#if CMD_RCU
+    Cmd_Registry*       Registry;
+    Cmd_List            Own;                /**< own commands while registry pinned */
+#if CMD_TABLE
+    const Cmd_Table*    OwnTable;
+#endif
+    uint8_t             Pins;               /**< depth of nested enter */
+    uint8_t             Slot;               /**< pinned slot of registry */
+#endif
+#if CMD_CHAR_CLASS
+    const Cmd_CharClass* CharClass;
+#endif
+#if CMD_CHUNK
+    Cmd*                ChunkCmd;
+    Cmd_CallbackFn      ChunkFn;
+    uint8_t             ChunkTypeIndex;
+    uint8_t             ChunkState;
+    uint8_t             Chunk;
+#endif
+#if CMD_STATS
+    Cmd_Stats           Stats;
+#endif
+#if CMD_PRIORITY
+    Stream_LenType      Skips[CMD_PRIORITY_LINES];  /**< offsets of pending lines that already run */
+    Stream_LenType      Scanned;            /**< pending bytes that scan for priority lines */
+    uint8_t             SkipsLen;
+#endif
+#if CMD_STATEMENT
+    char                StatementSeparator;
+    uint8_t             StopOnError;
+#endif
     char                ParamSeparator;
     uint8_t             InUseCmdTypeIndex;
 };
@@ -343,8 +897,19 @@ extern const char               CMD_PARAM_SEPARATOR;
     #define CMD_INIT(NAME, TYPES, FN)       {{FN}, CMD_STR_INIT(NAME), (TYPES)}
 #endif // CMD_MULTI_CALLBACK
 
+#if CMD_OPTIONS
+#if CMD_MULTI_CALLBACK
+    #define CMD_INIT_OPT(NAME, TYPES, OPTIONS, ...)     {{{__VA_ARGS__}}, CMD_STR_INIT(NAME), (TYPES), (OPTIONS)}
+#else
+    #define CMD_INIT_OPT(NAME, TYPES, OPTIONS, FN)      {{FN}, CMD_STR_INIT(NAME), (TYPES), (OPTIONS)}
+#endif // CMD_MULTI_CALLBACK
+#endif // CMD_OPTIONS
+
 void Cmd_init(Cmd* cmd, const char* name, Cmd_Type types);
 void Cmd_setTypes(Cmd* cmd, Cmd_Type types);
+#if CMD_OPTIONS
+    void Cmd_setOptions(Cmd* cmd, Cmd_Option options);
+#endif
 #if CMD_MULTI_CALLBACK
 #if CMD_TYPE_EXE
     void Cmd_onExecute(Cmd* cmd, Cmd_CallbackFn fn);
@@ -370,14 +935,85 @@ void Cmd_setTypes(Cmd* cmd, Cmd_Type types);
 #endif // CMD_MULTI_CALLBACK
 
 void CmdManager_init(CmdManager* manager, Cmd_Array* cmds, Cmd_LenType len);
+void CmdManager_resetInput(CmdManager* manager);
 void CmdManager_setStartWith(CmdManager* manager, Cmd_Str* startWith);
 void CmdManager_setEndWith(CmdManager* manager, Cmd_Str* endWith);
 void CmdManager_onNotFound(CmdManager* manager, Cmd_NotFoundFn notFound);
 void CmdManager_onOverflow(CmdManager* manager, Cmd_OverflowFn overflow);
+#if CMD_CAPTURE
+    void CmdManager_onCapture(CmdManager* manager, Cmd_CaptureFn capture, void* args);
+    void CmdManager_captureLine(CmdManager* manager, const char* line, Str_LenType len);
+#endif
+#if CMD_AUDIT
+    void CmdManager_onAudit(CmdManager* manager, Cmd_AuditFn audit, void* args);
+#endif
+#if CMD_RATE_LIMIT
+    void CmdLimit_init(Cmd_Limit* limit, uint16_t burst, uint16_t period);
+    void CmdManager_onOverload(CmdManager* manager, Cmd_OverloadFn overload);
+    void CmdManager_setLimit(CmdManager* manager, uint16_t burst, uint16_t period);
+    void CmdManager_setLimits(CmdManager* manager, Cmd_Limit* limits, Cmd_LenType len);
+    uint8_t CmdManager_setCmdLimit(CmdManager* manager, const char* name, uint16_t burst, uint16_t period);
+#endif // CMD_RATE_LIMIT
+#if CMD_CACHE
+    void CmdManager_onRespond(CmdManager* manager, Cmd_RespondFn respond);
+    void CmdManager_respond(CmdManager* manager, const char* data, Str_LenType len);
+    void CmdManager_setCache(CmdManager* manager, Cmd_CacheEntry* cache, Cmd_LenType len);
+    uint8_t CmdManager_setCmdCache(CmdManager* manager, const char* name, char* buffer, Str_LenType size, uint16_t ttl);
+    uint8_t CmdManager_invalidate(CmdManager* manager, const char* name);
+    void CmdManager_invalidateAll(CmdManager* manager);
+#endif // CMD_CACHE
+#if CMD_TICKS
+    void CmdManager_tick(CmdManager* manager, uint32_t ticks);
+#endif
 void CmdManager_setParamSeparator(CmdManager* manager, char sep);
+#if CMD_STATEMENT
+    void CmdManager_setStatementSeparator(CmdManager* manager, char sep);
+    void CmdManager_setStopOnError(CmdManager* manager, uint8_t enabled);
+#endif
 void CmdManager_setCommands(CmdManager* manager, Cmd_Array* cmds, Cmd_LenType len);
 void CmdManager_setPatternTypes(CmdManager* manager, Cmd_PatternTypes* patterns);
 
+#if CMD_TABLE
+    uint32_t CmdTable_size(Cmd_Array* cmds, Cmd_LenType len);
+    uint8_t CmdTable_build(Cmd_Table* table, Cmd_Array* cmds, Cmd_LenType len, void* memory, uint32_t size);
+    Mem_LenType CmdTable_find(const Cmd_Table* table, const Cmd_Str* name);
+    Cmd_CallbackFn CmdTable_getCallback(const Cmd_Table* table, Mem_LenType index, uint8_t typeIndex);
+    uint8_t CmdTable_hash(const char* name, Str_LenType len);
+    void CmdManager_setTable(CmdManager* manager, const Cmd_Table* table);
+#endif // CMD_TABLE
+
+#if CMD_INDEX
+    uint16_t CmdManager_indexSize(Cmd_Array* cmds, Cmd_LenType len);
+    uint8_t CmdManager_setIndex(CmdManager* manager, Cmd_IndexNode* nodes, uint16_t size, Cmd_LenType* order);
+    uint8_t CmdManager_buildIndex(CmdManager* manager);
+    Cmd_LenType CmdManager_complete(CmdManager* manager, const char* prefix, Str_LenType len, Cmd** result, Cmd_LenType max);
+    Cmd_LenType CmdManager_suggest(CmdManager* manager, const char* name, Str_LenType len, uint8_t maxDistance, Cmd_Suggestion* result, Cmd_LenType max);
+#endif // CMD_INDEX
+
+#if CMD_RCU
+    void CmdRegistry_init(Cmd_Registry* registry, Cmd_Array* cmds, Cmd_LenType len);
+    void CmdRegistry_publish(Cmd_Registry* registry, Cmd_Array* cmds, Cmd_LenType len);
+#if CMD_TABLE
+    void CmdRegistry_publishTable(Cmd_Registry* registry, const Cmd_Table* table);
+#endif
+    void CmdRegistry_synchronize(Cmd_Registry* registry);
+    uint8_t CmdRegistry_isQuiescent(Cmd_Registry* registry);
+    uint32_t CmdRegistry_version(Cmd_Registry* registry);
+    uint8_t CmdRegistry_enter(Cmd_Registry* registry, CmdManager* manager);
+    void CmdRegistry_leave(Cmd_Registry* registry, CmdManager* manager);
+    void CmdManager_setRegistry(CmdManager* manager, Cmd_Registry* registry);
+#endif // CMD_RCU
+
+#if CMD_CHAR_CLASS
+    void CmdCharClass_init(Cmd_CharClass* charClass);
+    void CmdManager_setCharClass(CmdManager* manager, const Cmd_CharClass* charClass);
+#endif // CMD_CHAR_CLASS
+
+#if CMD_STATS
+    Cmd_Stats* CmdManager_getStats(CmdManager* manager);
+    void CmdManager_resetStats(CmdManager* manager);
+#endif
+
 #if CMD_MANAGER_ARGS
     void  CmdManager_setArgs(CmdManager* manager, void* args);
     void* CmdManager_getArgs(CmdManager* manager);
@@ -387,10 +1023,22 @@ void CmdManager_setPatternTypes(CmdManager* manager, Cmd_PatternTypes* patterns)
     void CmdManager_handleStatic(CmdManager* manager, IStream* stream, char* buffer, Str_LenType len, Param_Cursor* cursor);
     void CmdManager_handle(CmdManager* manager, IStream* stream);
 #endif // CMD_STREAM
+#if CMD_PRIORITY
+    void CmdManager_handleBatch(CmdManager* manager, IStream* stream, char* buffer, Str_LenType len, Param_Cursor* cursor);
+#endif
+#if CMD_CHUNK
+    Cmd_Chunk CmdManager_getChunk(CmdManager* manager);
+#endif
 
 char* CmdManager_process(CmdManager* manager, char* buffer, Str_LenType len, Param_Cursor* cursor);
 void CmdManager_processLine(CmdManager* manager, char* buffer, Str_LenType lineLen, Param_Cursor* cursor);
 
+#if CMD_PREPARED
+    uint8_t CmdManager_prepare(CmdManager* manager, Cmd_Prepared* prepared, const char* line, Str_LenType len);
+    Cmd_Handled CmdManager_execute(CmdManager* manager, Cmd_Prepared* prepared, Param_Cursor* cursor);
+    uint8_t CmdPrepared_bind(Cmd_Prepared* prepared, const char* params, Str_LenType len);
+#endif // CMD_PREPARED
+
 // for compatibility
 #define CmdManager_nextParam    Param_next
 
@@ -0,0 +1,165 @@
+#include "CmdQueue.h"
+
+#if CMD_QUEUE
+
+#define __slot(Q, POS)          (&(Q)->Slots[(POS) & (Q)->Mask])
+#define __line(Q, POS)          (&(Q)->Lines[((POS) & (Q)->Mask) * (Q)->LineSize])
+
+/**
+ * @brief initialize queue, slots and lines must be valid until queue in use
+ *
+ * @param queue
+ * @param slots array of slots
+ * @param lines buffer with size * lineSize bytes
+ * @param size number of slots, must be power of 2
+ * @param lineSize size of each line buffer, max line length is lineSize - 1
+ */
+void CmdQueue_init(CmdQueue* queue, CmdQueue_Slot* slots, char* lines, uint32_t size, Str_LenType lineSize) {
+    queue->Slots = slots;
+    queue->Lines = lines;
+    queue->Mask = size - 1;
+    queue->LineSize = lineSize;
+    CmdQueue_reset(queue);
+}
+/**
+ * @brief drop all lines of queue, must not call while producers or consumer are active
+ *
+ * @param queue
+ */
+void CmdQueue_reset(CmdQueue* queue) {
+    uint32_t pos;
+
+    for (pos = 0; pos <= queue->Mask; pos++) {
+        queue->Slots[pos].Sequence = pos;
+        queue->Slots[pos].Len = 0;
+    }
+    queue->Dropped = 0;
+    queue->Head = 0;
+    queue->Tail = 0;
+}
+/**
+ * @brief push line into queue, can call from multiple producers at same time
+ * each producer claim a slot with single CAS, copy line and publish slot
+ *
+ * @param queue
+ * @param line
+ * @param len length of line without null terminator
+ * @return CmdQueue_Result
+ */
+CmdQueue_Result CmdQueue_push(CmdQueue* queue, const char* line, Str_LenType len) {
+    CmdQueue_Slot* slot;
+    uint32_t pos;
+    uint32_t seq;
+    int32_t diff;
+
+    if (len >= queue->LineSize) {
+        __atomic_add_fetch(&queue->Dropped, 1, __ATOMIC_RELAXED);
+        return CmdQueue_TooLong;
+    }
+    pos = __atomic_load_n(&queue->Head, __ATOMIC_RELAXED);
+    for (;;) {
+        slot = __slot(queue, pos);
+        seq = __atomic_load_n(&slot->Sequence, __ATOMIC_ACQUIRE);
+        diff = (int32_t) (seq - pos);
+        if (diff == 0) {
+            // slot is free, claim it
+            if (__atomic_compare_exchange_n(&queue->Head, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            // consumer not release slot yet
+            __atomic_add_fetch(&queue->Dropped, 1, __ATOMIC_RELAXED);
+            return CmdQueue_Full;
+        }
+        else {
+            // other producer claimed slot
+            pos = __atomic_load_n(&queue->Head, __ATOMIC_RELAXED);
+        }
+    }
+    Mem_copy(__line(queue, pos), line, len);
+    __line(queue, pos)[len] = '\0';
+    slot->Len = len;
+    __atomic_store_n(&slot->Sequence, pos + 1, __ATOMIC_RELEASE);
+
+    return CmdQueue_Ok;
+}
+/**
+ * @brief process ready lines in order of push, only one consumer can drain queue
+ * lines process in place, slot release after process
+ * drain stop on first slot that producer not publish yet, so order keep
+ *
+ * @param queue
+ * @param manager
+ * @param maxLines max number of lines to process, 0 for all ready lines
+ * @param cursor
+ * @return uint32_t number of processed lines
+ */
+uint32_t CmdQueue_drain(CmdQueue* queue, CmdManager* manager, uint32_t maxLines, Param_Cursor* cursor) {
+    char* line;
+    Str_LenType len;
+    uint32_t count = 0;
+
+    while (maxLines == 0 || count < maxLines) {
+        line = CmdQueue_peek(queue, &len);
+        if (line == NULL) {
+            break;
+        }
+    #if CMD_CAPTURE
+        CmdManager_captureLine(manager, line, len);
+    #endif
+        CmdManager_processLine(manager, line, len, cursor);
+        CmdQueue_release(queue);
+        count++;
+    }
+
+    return count;
+}
+/**
+ * @brief return first ready line without remove it, only consumer can call it,
+ * line is valid until CmdQueue_release
+ *
+ * @param queue
+ * @param len length of line
+ * @return char* NULL if no line ready
+ */
+char* CmdQueue_peek(CmdQueue* queue, Str_LenType* len) {
+    CmdQueue_Slot* slot = __slot(queue, queue->Tail);
+
+    if (__atomic_load_n(&slot->Sequence, __ATOMIC_ACQUIRE) != queue->Tail + 1) {
+        return NULL;
+    }
+    *len = slot->Len;
+    return __line(queue, queue->Tail);
+}
+/**
+ * @brief release first line that returned by CmdQueue_peek, slot can use by producers
+ *
+ * @param queue
+ */
+void CmdQueue_release(CmdQueue* queue) {
+    uint32_t pos = queue->Tail;
+
+    __atomic_store_n(&__slot(queue, pos)->Sequence, pos + queue->Mask + 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&queue->Tail, pos + 1, __ATOMIC_RELAXED);
+}
+/**
+ * @brief return number of claimed slots, approximate while producers are active
+ *
+ * @param queue
+ * @return uint32_t
+ */
+uint32_t CmdQueue_len(CmdQueue* queue) {
+    return __atomic_load_n(&queue->Head, __ATOMIC_RELAXED) - __atomic_load_n(&queue->Tail, __ATOMIC_RELAXED);
+}
+/**
+ * @brief return number of dropped lines
+ *
+ * @param queue
+ * @return uint32_t
+ */
+uint32_t CmdQueue_dropped(CmdQueue* queue) {
+    return __atomic_load_n(&queue->Dropped, __ATOMIC_RELAXED);
+}
+
+#endif // CMD_QUEUE
@@ -0,0 +1,92 @@
+/**
+ * @file CmdQueue.h
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief this library can use for feed lines from multiple producers into one CmdManager
+ * bounded lock free queue, producers push whole lines without lock and never wait
+ * for each other, single consumer drain lines in order and process them in place
+ * slots and line buffers provide by user, need atomic compare and swap
+ * (GCC __atomic builtins), so it's safe for threads and ISRs of cores that support CAS
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _CMD_QUEUE_H_
+#define _CMD_QUEUE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "CmdManager.h"
+
+/********************************************************************************/
+/*                              Configuration                                   */
+/********************************************************************************/
+
+/**
+ * @brief enable multi producer line queue, need atomic compare and swap
+ */
+#ifndef CMD_QUEUE
+#define CMD_QUEUE                           0
+#endif
+/**
+ * @brief size of cache line, producer and consumer positions keep in separate lines
+ */
+#ifndef CMD_QUEUE_CACHE_LINE
+#define CMD_QUEUE_CACHE_LINE                64
+#endif
+
+/********************************************************************************/
+
+#if CMD_QUEUE
+
+/**
+ * @brief result of push functions
+ */
+typedef enum {
+    CmdQueue_Ok                 = 0,    /**< line pushed */
+    CmdQueue_Full               = 1,    /**< no free slot, line dropped */
+    CmdQueue_TooLong            = 2,    /**< line not fit in slot, line dropped */
+} CmdQueue_Result;
+/**
+ * @brief hold state of each slot, sequence number tell slot is free or ready
+ */
+typedef struct {
+    uint32_t            Sequence;
+    Str_LenType         Len;
+} CmdQueue_Slot;
+/**
+ * @brief hold properties of queue
+ */
+typedef struct {
+    CmdQueue_Slot*      Slots;
+    char*               Lines;          /**< Size * LineSize bytes, line of each slot */
+    uint32_t            Mask;           /**< Size - 1 */
+    Str_LenType         LineSize;       /**< size of each line buffer, include null terminator */
+    uint32_t            Dropped;        /**< number of lines that dropped on push */
+    uint8_t             Padding0[CMD_QUEUE_CACHE_LINE];
+    uint32_t            Head;           /**< next push position, shared between producers */
+    uint8_t             Padding1[CMD_QUEUE_CACHE_LINE - sizeof(uint32_t)];
+    uint32_t            Tail;           /**< next drain position, only consumer */
+} CmdQueue;
+
+void CmdQueue_init(CmdQueue* queue, CmdQueue_Slot* slots, char* lines, uint32_t size, Str_LenType lineSize);
+void CmdQueue_reset(CmdQueue* queue);
+
+CmdQueue_Result CmdQueue_push(CmdQueue* queue, const char* line, Str_LenType len);
+uint32_t CmdQueue_drain(CmdQueue* queue, CmdManager* manager, uint32_t maxLines, Param_Cursor* cursor);
+char* CmdQueue_peek(CmdQueue* queue, Str_LenType* len);
+void CmdQueue_release(CmdQueue* queue);
+
+uint32_t CmdQueue_len(CmdQueue* queue);
+uint32_t CmdQueue_dropped(CmdQueue* queue);
+
+#endif // CMD_QUEUE
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* _CMD_QUEUE_H_ */
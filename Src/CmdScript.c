@@ -0,0 +1,261 @@
+#include "CmdScript.h"
+
+#if CMD_SCRIPT
+
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @brief hold properties of each thread
+ */
+typedef struct {
+    CmdManager          Manager;        /**< session of thread */
+    pthread_t           Thread;
+    char*               Data;
+    size_t              Len;
+    uint64_t            Lines;
+} CmdScript_Worker;
+
+/* private functions */
+static void* CmdScript_work(void* args);
+static uint64_t CmdScript_process(CmdManager* manager, char* data, size_t len);
+static char* CmdScript_findEnd(CmdManager* manager, char* data, char* end);
+/**
+ * @brief map script file and run it
+ *
+ * @param manager configured manager, used as template of thread sessions
+ * @param path
+ * @param threads max number of threads, 1 for sequential
+ * @param stats result of run, can be NULL
+ * @return CmdScript_Result
+ */
+CmdScript_Result CmdScript_run(CmdManager* manager, const char* path, uint8_t threads, CmdScript_Stats* stats) {
+    CmdScript_Result result;
+    struct stat st;
+    char* data;
+    int fd;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return CmdScript_OpenError;
+    }
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return CmdScript_OpenError;
+    }
+    if (st.st_size == 0) {
+        close(fd);
+        return CmdScript_runBuffer(manager, NULL, 0, threads, stats);
+    }
+    // private mapping, manager can modify lines without touch file
+    data = (char*) mmap(NULL, (size_t) st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return CmdScript_MapError;
+    }
+    madvise(data, (size_t) st.st_size, MADV_SEQUENTIAL);
+    result = CmdScript_runBuffer(manager, data, (size_t) st.st_size, threads, stats);
+    munmap(data, (size_t) st.st_size);
+    return result;
+}
+/**
+ * @brief run script in writable buffer
+ *
+ * @param manager configured manager, used as template of thread sessions
+ * @param data content of script, lines modify in place
+ * @param len
+ * @param threads max number of threads, 1 for sequential
+ * @param stats result of run, can be NULL
+ * @return CmdScript_Result
+ */
+CmdScript_Result CmdScript_runBuffer(CmdManager* manager, char* data, size_t len, uint8_t threads, CmdScript_Stats* stats) {
+    CmdScript_Worker workers[CMD_SCRIPT_MAX_THREADS];
+    CmdScript_Stats temp;
+    char* end = data + len;
+    char* pos = data;
+    uint8_t count = 0;
+    uint8_t created;
+    uint8_t index;
+
+    if (stats == NULL) {
+        stats = &temp;
+    }
+    stats->Lines = 0;
+    stats->Unterminated = 0;
+    stats->Threads = 1;
+    if (threads > CMD_SCRIPT_MAX_THREADS) {
+        threads = CMD_SCRIPT_MAX_THREADS;
+    }
+    if (len / CMD_SCRIPT_MIN_CHUNK < threads) {
+        threads = (uint8_t) (len / CMD_SCRIPT_MIN_CHUNK);
+    }
+    if (threads <= 1 || CmdScript_isSequential(manager)) {
+        // same manager, multi line commands continue between lines
+        stats->Lines = CmdScript_process(manager, data, len);
+        return CmdScript_Ok;
+    }
+    // split into line aligned chunks
+    while (pos < end && count < threads) {
+        CmdScript_Worker* worker = &workers[count];
+        char* chunkEnd = count == threads - 1 ? end : pos + (size_t) (end - pos) / (threads - count);
+
+        if (chunkEnd < end) {
+            chunkEnd = CmdScript_findEnd(manager, chunkEnd, end);
+            chunkEnd = chunkEnd != NULL ? chunkEnd + manager->EndWith->Len : end;
+        }
+        worker->Manager = *manager;
+        CmdManager_resetInput(&worker->Manager);
+    #if CMD_CACHE
+        // entries of cache can not fill from multiple threads
+        worker->Manager.Cache = NULL;
+        worker->Manager.CacheLen = 0;
+        worker->Manager.Recording = NULL;
+    #endif
+    #if CMD_STATS
+        CmdManager_resetStats(&worker->Manager);
+    #endif
+        worker->Data = pos;
+        worker->Len = (size_t) (chunkEnd - pos);
+        worker->Lines = 0;
+        pos = chunkEnd;
+        count++;
+    }
+    // first chunk run in caller thread
+    for (created = 1; created < count; created++) {
+        if (pthread_create(&workers[created].Thread, NULL, CmdScript_work, &workers[created]) != 0) {
+            break;
+        }
+    }
+    // chunks that thread not created for them run in caller thread too
+    CmdScript_work(&workers[0]);
+    for (index = created; index < count; index++) {
+        CmdScript_work(&workers[index]);
+    }
+    for (index = 1; index < created; index++) {
+        pthread_join(workers[index].Thread, NULL);
+    }
+    for (index = 0; index < count; index++) {
+        CmdScript_Worker* worker = &workers[index];
+        stats->Lines += worker->Lines;
+        if (worker->Manager.InUseFn != NULL) {
+            stats->Unterminated++;
+        }
+    #if CMD_COALESCE
+        manager->Stats.Coalesced += worker->Manager.Stats.Coalesced;
+    #endif
+    }
+#if CMD_CACHE
+    // Set of threads may change responses
+    CmdManager_invalidateAll(manager);
+#endif
+    stats->Threads = created;
+    return CmdScript_Ok;
+}
+/**
+ * @brief check script must run sequentially, when any command have Cmd_Option_Multiline
+ * or manager has rate limits
+ *
+ * @param manager
+ * @return uint8_t
+ */
+uint8_t CmdScript_isSequential(CmdManager* manager) {
+#if CMD_MULTILINE
+    Cmd_LenType index;
+    uint8_t sequential = 0;
+#endif
+#if CMD_RATE_LIMIT
+    if (manager->Limit.Burst != 0 || manager->Limits != NULL) {
+        return 1;
+    }
+#endif // CMD_RATE_LIMIT
+#if CMD_MULTILINE
+#if CMD_RCU
+    // check current version of shared commands
+    if (manager->Registry != NULL) {
+        CmdRegistry_enter(manager->Registry, manager);
+    }
+#endif // CMD_RCU
+#if CMD_TABLE
+    if (manager->Table != NULL) {
+        for (index = 0; index < manager->Table->Len && !sequential; index++) {
+            sequential = (manager->Table->Options[index] & Cmd_Option_Multiline) != 0;
+        }
+    }
+    else
+#endif // CMD_TABLE
+    {
+        for (index = 0; index < manager->List.Len && !sequential; index++) {
+            sequential = (CmdList_get(manager->List.Cmds, index)->Options.Flags & Cmd_Option_Multiline) != 0;
+        }
+    }
+#if CMD_RCU
+    if (manager->Registry != NULL) {
+        CmdRegistry_leave(manager->Registry, manager);
+    }
+#endif // CMD_RCU
+    if (sequential) {
+        return 1;
+    }
+#endif // CMD_MULTILINE
+    return manager->InUseFn != NULL;
+}
+
+static void* CmdScript_work(void* args) {
+    CmdScript_Worker* worker = (CmdScript_Worker*) args;
+
+    worker->Lines = CmdScript_process(&worker->Manager, worker->Data, worker->Len);
+    return NULL;
+}
+static uint64_t CmdScript_process(CmdManager* manager, char* data, size_t len) {
+    Param_Cursor cursor;
+    char* end = data + len;
+    char* lineEnd;
+    uint64_t lines = 0;
+
+    while (data < end) {
+        lineEnd = CmdScript_findEnd(manager, data, end);
+        if (lineEnd == NULL) {
+            // last line of script without EndWith, copy for null terminator
+            Str_LenType lineLen = (Str_LenType) (end - data);
+            char* line = (char*) malloc((size_t) lineLen + 1);
+            if (line != NULL) {
+                memcpy(line, data, (size_t) lineLen);
+                line[lineLen] = '\0';
+                CmdManager_processLine(manager, line, lineLen, &cursor);
+                lines++;
+            }
+            free(line);
+            break;
+        }
+        if (lineEnd != data) {
+            *lineEnd = '\0';
+            CmdManager_processLine(manager, data, (Str_LenType) (lineEnd - data), &cursor);
+            lines++;
+        }
+        data = lineEnd + manager->EndWith->Len;
+    }
+    return lines;
+}
+static char* CmdScript_findEnd(CmdManager* manager, char* data, char* end) {
+    const char* pattern = manager->EndWith->Text;
+    size_t patternLen = manager->EndWith->Len;
+
+    while ((size_t) (end - data) >= patternLen) {
+        data = (char*) memchr(data, *pattern, (size_t) (end - data) - (patternLen - 1));
+        if (data == NULL) {
+            return NULL;
+        }
+        if (memcmp(data, pattern, patternLen) == 0) {
+            return data;
+        }
+        data++;
+    }
+    return NULL;
+}
+
+#endif // CMD_SCRIPT
@@ -0,0 +1,82 @@
+/**
+ * @file CmdScript.h
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief this library can use for run large command scripts on POSIX hosts
+ * script memory map and split into line aligned chunks, each chunk process
+ * in separate thread with own copy of manager, commands and callbacks shared,
+ * so callbacks must be thread safe, each line must fit in Str_LenType
+ * scripts with multi line commands (Cmd_Option_Multiline) or rate limits run sequentially,
+ * limits can not split between threads without change the budget
+ * threads don't use cache, cache of manager invalidate after parallel run
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _CMD_SCRIPT_H_
+#define _CMD_SCRIPT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "CmdManager.h"
+
+/********************************************************************************/
+/*                              Configuration                                   */
+/********************************************************************************/
+
+/**
+ * @brief enable script runner, need mmap and pthread
+ */
+#ifndef CMD_SCRIPT
+#define CMD_SCRIPT                          0
+#endif
+/**
+ * @brief max number of threads that run a script
+ */
+#ifndef CMD_SCRIPT_MAX_THREADS
+#define CMD_SCRIPT_MAX_THREADS              16
+#endif
+/**
+ * @brief min size of each chunk in bytes, small scripts use less threads
+ */
+#ifndef CMD_SCRIPT_MIN_CHUNK
+#define CMD_SCRIPT_MIN_CHUNK                (64 * 1024)
+#endif
+
+/********************************************************************************/
+
+#if CMD_SCRIPT
+
+#include <stddef.h>
+
+/**
+ * @brief result of script functions
+ */
+typedef enum {
+    CmdScript_Ok                = 0,    /**< script run */
+    CmdScript_OpenError         = 1,    /**< can not open file */
+    CmdScript_MapError          = 2,    /**< can not map file */
+} CmdScript_Result;
+/**
+ * @brief result of script run
+ */
+typedef struct {
+    uint64_t            Lines;          /**< number of processed lines */
+    uint32_t            Unterminated;   /**< chunks that end while a command is in use */
+    uint8_t             Threads;        /**< number of used threads, less than requested if thread create failed */
+} CmdScript_Stats;
+
+CmdScript_Result CmdScript_run(CmdManager* manager, const char* path, uint8_t threads, CmdScript_Stats* stats);
+CmdScript_Result CmdScript_runBuffer(CmdManager* manager, char* data, size_t len, uint8_t threads, CmdScript_Stats* stats);
+uint8_t CmdScript_isSequential(CmdManager* manager);
+
+#endif // CMD_SCRIPT
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* _CMD_SCRIPT_H_ */
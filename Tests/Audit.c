@@ -0,0 +1,109 @@
+/**
+ * @file Audit.c
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief test records of processed and prepared commands, count of written records and failed writes
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "Test.h"
+#include "CmdAudit.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_AUDIT_PATH         "TestAudit.log"
+#define TEST_AUDIT_SLOTS        4
+#define TEST_AUDIT_LINES        16
+
+static Cmd_Handled Test_onSet(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    return Cmd_Done;
+}
+
+static Cmd CMD_LED = CMD_INIT("led", Cmd_Type_Set, NULL, Test_onSet);
+
+static Cmd_Array CMDS[] = {
+    &CMD_LED,
+};
+
+int main(void) {
+    static CmdAudit audit;
+    static CmdQueue_Slot slots[TEST_AUDIT_SLOTS];
+    static char events[TEST_AUDIT_SLOTS * CMD_AUDIT_EVENT_SIZE];
+    static char log[4096];
+    CmdAudit_Session session;
+    CmdManager manager;
+    Cmd_Prepared prepared;
+    Param_Cursor cursor;
+    char line[8];
+    FILE* file;
+    size_t size;
+    size_t pos;
+    uint32_t records = 0;
+    uint32_t lost = 0;
+    uint32_t dropped;
+    uint16_t len;
+    int16_t index;
+    int count;
+
+    remove(TEST_AUDIT_PATH);
+    CmdManager_init(&manager, CMDS, CMD_ARR_LEN(CMDS));
+    Test_assert(CmdAudit_start(&audit, TEST_AUDIT_PATH, slots, events, TEST_AUDIT_SLOTS) == CmdAudit_Ok);
+    CmdAudit_attach(&audit, &session, &manager, 7);
+
+    // prepared command write a record too
+    Test_assert(CmdManager_prepare(&manager, &prepared, "led=1", 5));
+    Test_assert(CmdManager_execute(&manager, &prepared, &cursor) == Cmd_Done);
+    // more lines than slots, some records drop
+    for (count = 1; count < TEST_AUDIT_LINES; count++) {
+        strcpy(line, "led=2");
+        CmdManager_processLine(&manager, line, 5, &cursor);
+    }
+    CmdAudit_stop(&audit);
+
+    file = fopen(TEST_AUDIT_PATH, "rb");
+    Test_assert(file != NULL);
+    size = fread(log, 1, sizeof(log), file);
+    fclose(file);
+    remove(TEST_AUDIT_PATH);
+    Test_assert(size > CMD_AUDIT_HEADER_SIZE && memcmp(log, "CMDA", 4) == 0);
+
+    pos = CMD_AUDIT_HEADER_SIZE;
+    while (pos + CMD_AUDIT_RECORD_HEADER <= size) {
+        memcpy(&len, &log[pos + 16], sizeof(len));
+        if ((uint8_t) log[pos + 15] == CmdAudit_Lost) {
+            memcpy(&dropped, &log[pos + CMD_AUDIT_RECORD_HEADER], sizeof(dropped));
+            lost += dropped;
+        }
+        else {
+            if (records == 0) {
+                // first record is prepared command, lost record can write before it
+                memcpy(&index, &log[pos + 12], sizeof(index));
+                Test_assert(index == 0);
+                Test_assert((uint8_t) log[pos + 14] == Cmd_Type_Set);
+                Test_assert(len == 1 && log[pos + CMD_AUDIT_RECORD_HEADER] == '1');
+            }
+            records++;
+        }
+        pos += CMD_AUDIT_RECORD_HEADER + len;
+    }
+    Test_assert(pos == size);
+    Test_assert(records + lost == TEST_AUDIT_LINES);
+    // lost records are not counted as written
+    Test_assert(audit.Written == records);
+    Test_assert(audit.Failed == 0);
+
+#if defined(__linux__)
+    // device without space fail every write
+    Test_assert(CmdAudit_start(&audit, "/dev/full", slots, events, TEST_AUDIT_SLOTS) == CmdAudit_Ok);
+    CmdAudit_attach(&audit, &session, &manager, 8);
+    strcpy(line, "led=3");
+    CmdManager_processLine(&manager, line, 5, &cursor);
+    CmdAudit_stop(&audit);
+    Test_assert(audit.Written == 0);
+    Test_assert(audit.Failed != 0);
+#endif
+
+    return 0;
+}
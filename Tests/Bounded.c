@@ -0,0 +1,88 @@
+/**
+ * @file Bounded.c
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief test bounded mode reject long lines and names on line and batch paths,
+ * tables only search with lookup
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "Test.h"
+#include <string.h>
+
+static int sets;
+static int notFounds;
+static int overflows;
+
+static Cmd_Handled Test_onSet(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    sets++;
+    return Cmd_Done;
+}
+static void onNotFound(CmdManager* manager, char* str) {
+    notFounds++;
+}
+static void onOverflow(CmdManager* manager) {
+    overflows++;
+}
+
+static Cmd CMD_LED = CMD_INIT("led", Cmd_Type_Set, NULL, Test_onSet);
+static Cmd CMD_PWM = CMD_INIT("pwm", Cmd_Type_Set, NULL, Test_onSet);
+static Cmd CMD_LONG = CMD_INIT("verylongname", Cmd_Type_Set, NULL, Test_onSet);
+
+static Cmd_Array CMDS[] = {
+    &CMD_PWM,
+    &CMD_LED,
+    &CMD_LONG,
+};
+
+int main(void) {
+    CmdManager manager;
+    Cmd_Table table;
+    Cmd_Str name;
+    void* memory[32];
+    IStream stream;
+    uint8_t streamBuffer[128];
+    char buffer[32];
+    char line[32];
+    Param_Cursor cursor;
+    int round;
+
+    CmdManager_init(&manager, CMDS, CMD_ARR_LEN(CMDS));
+    CmdManager_onNotFound(&manager, onNotFound);
+    CmdManager_onOverflow(&manager, onOverflow);
+    IStream_init(&stream, NULL, streamBuffer, sizeof(streamBuffer));
+
+    // line path
+    strcpy(line, "led=1");
+    CmdManager_processLine(&manager, line, 5, &cursor);
+    strcpy(line, "led=1,2,3,4,5,6,7");
+    CmdManager_processLine(&manager, line, 17, &cursor);
+    strcpy(line, "verylongname=1");
+    CmdManager_processLine(&manager, line, 14, &cursor);
+    Test_assert(sets == 1);
+    Test_assert(overflows == 1);
+    Test_assert(notFounds == 1);
+
+    // batch path, long line fit in buffer but not in CMD_LINE_MAX_LEN
+    sets = 0;
+    overflows = 0;
+    Test_feed(&stream, "led=1\npwm=1,2,3,4,5,6,7\npwm=2\n");
+    for (round = 0; round < 8 && IStream_available(&stream) > 0; round++) {
+        CmdManager_handleBatch(&manager, &stream, buffer, sizeof(buffer), &cursor);
+    }
+    Test_assert(IStream_available(&stream) == 0);
+    Test_assert(sets == 2);
+    Test_assert(overflows == 1);
+
+    // table search only with lookup
+    Test_assert(CmdTable_build(&table, CMDS, CMD_ARR_LEN(CMDS), memory, sizeof(memory)));
+    name.Text = "pwm";
+    name.Len = 3;
+    Test_assert(CmdTable_find(&table, &name) >= 0);
+    table.Lookup = NULL;
+    Test_assert(CmdTable_find(&table, &name) == -1);
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file Cache.c
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief test cached Get responses, entries after change of commands, Set of prepared commands
+ * and published list longer than cache
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "Test.h"
+#include <string.h>
+
+static int gets;
+static char value[2] = "0";
+static char response[16];
+static Str_LenType responseLen;
+
+static Cmd_Handled Test_onSet(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    value[0] = cursor->Ptr[0];
+    return Cmd_Done;
+}
+static Cmd_Handled Test_onGet(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    gets++;
+    CmdManager_respond(manager, cmd->CmdName.Text, cmd->CmdName.Len);
+    CmdManager_respond(manager, value, 1);
+    return Cmd_Done;
+}
+static void onRespond(CmdManager* manager, const char* data, Str_LenType len) {
+    Mem_copy(&response[responseLen], data, len);
+    responseLen += len;
+}
+
+static Cmd CMD_LED = CMD_INIT("led", Cmd_Type_Set | Cmd_Type_Get, NULL, Test_onSet, Test_onGet);
+static Cmd CMD_PWM = CMD_INIT("pwm", Cmd_Type_Set | Cmd_Type_Get, NULL, Test_onSet, Test_onGet);
+static Cmd CMD_FAN = CMD_INIT("fan", Cmd_Type_Set | Cmd_Type_Get, NULL, Test_onSet, Test_onGet);
+
+static Cmd_Array CMDS[] = {
+    &CMD_LED,
+    &CMD_PWM,
+};
+static Cmd_Array SWAPPED[] = {
+    &CMD_PWM,
+    &CMD_LED,
+};
+static Cmd_Array LONGER[] = {
+    &CMD_LED,
+    &CMD_PWM,
+    &CMD_FAN,
+};
+
+static void get(CmdManager* manager, const char* name) {
+    char line[16];
+    Param_Cursor cursor;
+
+    strcpy(line, name);
+    strcat(line, "?");
+    responseLen = 0;
+    CmdManager_processLine(manager, line, (Str_LenType) strlen(line), &cursor);
+    response[responseLen] = '\0';
+}
+
+int main(void) {
+    CmdManager manager;
+    Cmd_Registry registry;
+    // guard after cache catch access out of array
+    struct {
+        Cmd_CacheEntry  Entries[CMD_ARR_LEN(CMDS)];
+        Cmd_CacheEntry  Guard;
+    } cache = {0};
+    char ledBuffer[8];
+    char guardBuffer[] = "bad";
+    Cmd_Prepared prepared;
+    Param_Cursor cursor;
+
+    CmdManager_init(&manager, CMDS, CMD_ARR_LEN(CMDS));
+    CmdManager_onRespond(&manager, onRespond);
+    CmdManager_setCache(&manager, cache.Entries, CMD_ARR_LEN(cache.Entries));
+    Test_assert(CmdManager_setCmdCache(&manager, "led", ledBuffer, sizeof(ledBuffer), 100));
+
+    // second Get serve from cache
+    get(&manager, "led");
+    get(&manager, "led");
+    Test_assert(gets == 1);
+    Test_assert(manager.Stats.CacheHits == 1);
+    Test_assert(strcmp(response, "led0") == 0);
+
+    // entry of led must not serve pwm after order of commands changed
+    CmdManager_setCommands(&manager, SWAPPED, CMD_ARR_LEN(SWAPPED));
+    get(&manager, "pwm");
+    Test_assert(gets == 2);
+    Test_assert(strcmp(response, "pwm0") == 0);
+    get(&manager, "led");
+    Test_assert(gets == 3);
+
+    // Set of prepared command invalidate response
+    CmdManager_setCommands(&manager, CMDS, CMD_ARR_LEN(CMDS));
+    get(&manager, "led");
+    get(&manager, "led");
+    Test_assert(gets == 3);
+    Test_assert(CmdManager_prepare(&manager, &prepared, "led=1", 5));
+    Test_assert(CmdManager_execute(&manager, &prepared, &cursor) == Cmd_Done);
+    get(&manager, "led");
+    Test_assert(gets == 4);
+    Test_assert(strcmp(response, "led1") == 0);
+
+    // fan is after end of cache in published version
+    cache.Guard.Key = &CMD_FAN;
+    cache.Guard.Buffer = guardBuffer;
+    cache.Guard.Size = sizeof(guardBuffer);
+    cache.Guard.Len = 3;
+    cache.Guard.TTL = 100;
+    cache.Guard.Time = manager.Ticks;
+    cache.Guard.Valid = 1;
+    CmdRegistry_init(&registry, CMDS, CMD_ARR_LEN(CMDS));
+    CmdManager_setRegistry(&manager, &registry);
+    CmdRegistry_publish(&registry, LONGER, CMD_ARR_LEN(LONGER));
+    get(&manager, "fan");
+    Test_assert(gets == 5);
+    Test_assert(strcmp(response, "fan1") == 0);
+    CmdManager_invalidateAll(&manager);
+    Test_assert(cache.Guard.Valid);
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file Capture.c
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief test capture of stream and queue lines, replay of log and stop after failed write
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "Test.h"
+#include "CmdCapture.h"
+#include "CmdQueue.h"
+
+typedef struct {
+    uint8_t     Data[256];
+    uint32_t    Len;
+    uint32_t    FailAt;         /**< number of write that fail, 0 for never */
+    uint32_t    Writes;
+} Test_Log;
+
+static int sets;
+static uint32_t clock;
+
+static Cmd_Handled Test_onSet(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    sets++;
+    return Cmd_Done;
+}
+static uint8_t Test_write(void* args, const uint8_t* data, uint32_t len) {
+    Test_Log* log = (Test_Log*) args;
+
+    if (++log->Writes == log->FailAt || log->Len + len > sizeof(log->Data)) {
+        return 1;
+    }
+    Mem_copy(&log->Data[log->Len], data, len);
+    log->Len += len;
+    return 0;
+}
+static uint32_t Test_time(void) {
+    return clock += 10;
+}
+
+static const Cmd CMD_LED = CMD_INIT("led", Cmd_Type_Set, NULL, Test_onSet, NULL, NULL, NULL);
+
+static const Cmd_Array CMDS[] = {
+    &CMD_LED,
+};
+
+int main(void) {
+    CmdManager manager;
+    CmdCapture capture;
+    CmdCapture_Reader reader;
+    CmdCapture_Record record;
+    CmdCapture_Result result;
+    Test_Log log = {0};
+    CmdQueue queue;
+    CmdQueue_Slot slots[4];
+    char lines[4 * 16];
+    IStream stream;
+    uint8_t streamBuffer[64];
+    char buffer[32];
+    char replay[64];
+    uint32_t replayLen = 0;
+    uint32_t records = 0;
+    Param_Cursor cursor;
+
+    CmdManager_init(&manager, (Cmd_Array*) CMDS, CMD_ARR_LEN(CMDS));
+    CmdCapture_init(&capture, Test_write, Test_time, &log);
+    CmdCapture_attach(&capture, &manager);
+    IStream_init(&stream, NULL, streamBuffer, sizeof(streamBuffer));
+    CmdQueue_init(&queue, slots, lines, 4, 16);
+
+    Test_feed(&stream, "led=1\n");
+    while (IStream_available(&stream) > 0) {
+        CmdManager_handleStatic(&manager, &stream, buffer, sizeof(buffer), &cursor);
+    }
+    Test_assert(CmdQueue_push(&queue, "led=2", 5) == CmdQueue_Ok);
+    Test_assert(CmdQueue_drain(&queue, &manager, 0, &cursor) == 1);
+    Test_assert(sets == 2);
+    // concatenation of records is same as input
+    Test_assert(CmdCapture_open(&reader, log.Data, log.Len) == CmdCapture_Ok);
+    while (CmdCapture_next(&reader, &record) == CmdCapture_Ok) {
+        Test_assert(replayLen + record.Len <= sizeof(replay));
+        Mem_copy(&replay[replayLen], record.Data, record.Len);
+        replayLen += record.Len;
+        records++;
+    }
+    // line of queue and its EndWith are single record
+    Test_assert(records == 2);
+    Test_assert(replayLen == 12);
+    Test_assert(Mem_compare(replay, "led=1\nled=2\n", 12) == 0);
+
+    // payload fail after head, log must stop to stay aligned
+    log.FailAt = log.Writes + 2;
+    Test_assert(CmdCapture_write(&capture, "led=3\n", 6) == CmdCapture_WriteError);
+    Test_assert(CmdCapture_write(&capture, "led=4\n", 6) == CmdCapture_WriteError);
+    Test_assert(capture.Dropped == 2);
+    Test_assert(CmdCapture_open(&reader, log.Data, log.Len) == CmdCapture_Ok);
+    replayLen = 0;
+    while ((result = CmdCapture_next(&reader, &record)) == CmdCapture_Ok) {
+        replayLen += record.Len;
+    }
+    // only head of failed record is in log, reader see it as truncated end
+    Test_assert(result == CmdCapture_Truncated);
+    Test_assert(replayLen == 12);
+
+    return 0;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file CharClass.c
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief test tokenizer with character class table resolve lines same as Str functions
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "Test.h"
+#include <string.h>
+
+typedef struct {
+    int         Calls[CMD_TYPE_LEN];
+    int         NotFounds;
+    int32_t     Value;
+} Test_Result;
+
+static Test_Result* result;
+
+static Cmd_Handled Test_onCmd(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    Param param;
+    uint8_t index = 0;
+
+    while (((uint32_t) type >> index) > 1) {
+        index++;
+    }
+    result->Calls[index]++;
+    if (type == Cmd_Type_Set && CmdManager_nextParam(cursor, &param) != NULL &&
+        param.Value.Type == Param_ValueType_Number) {
+        result->Value = param.Value.Number;
+    }
+    return Cmd_Done;
+}
+static void onNotFound(CmdManager* manager, char* str) {
+    result->NotFounds++;
+}
+
+static const Cmd CMD_LED = CMD_INIT("led", Cmd_Type_Any, Test_onCmd);
+static const Cmd CMD_PWM = CMD_INIT("pwm", Cmd_Type_Set, Test_onCmd);
+
+static const Cmd_Array CMDS[] = {
+    &CMD_LED,
+    &CMD_PWM,
+};
+
+static const char* const LINES[] = {
+    "led",
+    "  led=12",
+    "LED?",
+    "Led=?",
+    "pwm=7",
+    "pwm?",
+    "pw\bwm=3",
+    "lex\bd",
+    "pwm=4\b5",
+    "led=1\b\b?",
+    "fan=1",
+    "",
+};
+
+static void Test_run(CmdManager* manager, Test_Result* output) {
+    char line[32];
+    Param_Cursor cursor;
+    uint8_t index;
+
+    result = output;
+    for (index = 0; index < CMD_ARR_LEN(LINES); index++) {
+        Str_LenType len = (Str_LenType) strlen(LINES[index]);
+        memcpy(line, LINES[index], (size_t) len + 1);
+        CmdManager_processLine(manager, line, len, &cursor);
+    }
+}
+
+int main(void) {
+    CmdManager manager;
+    Cmd_CharClass charClass;
+    Test_Result expected = {0};
+    Test_Result actual = {0};
+    uint8_t index;
+
+    CmdManager_init(&manager, (Cmd_Array*) CMDS, CMD_ARR_LEN(CMDS));
+    CmdManager_onNotFound(&manager, onNotFound);
+    Test_run(&manager, &expected);
+
+    CmdCharClass_init(&charClass);
+    Test_assert(charClass.Class[0] == Cmd_Char_None);
+    Test_assert(charClass.Class[' '] & Cmd_Char_Space);
+    Test_assert(charClass.Class['L'] & Cmd_Char_Name);
+    Test_assert(charClass.Class['\b'] == Cmd_Char_Backspace);
+    CmdManager_setCharClass(&manager, &charClass);
+    Test_run(&manager, &actual);
+
+    for (index = 0; index < CMD_TYPE_LEN; index++) {
+        Test_assert(actual.Calls[index] == expected.Calls[index]);
+    }
+    Test_assert(actual.NotFounds == expected.NotFounds);
+    Test_assert(actual.Value == expected.Value);
+    Test_assert(actual.Value == 5);
+    Test_assert(actual.Calls[Cmd_TypeIndex_Set] == 4);
+    Test_assert(actual.Calls[Cmd_TypeIndex_Get] == 2);
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file Chunk.c
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief test params of long lines pass in chunks and EndWith that not fit with last chunk
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "Test.h"
+
+static char params[64];
+static Str_LenType paramsLen;
+static int chunks;
+static int firsts;
+static int lasts;
+static int overflows;
+
+static Cmd_Handled Hex_onSet(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    Cmd_Chunk chunk = CmdManager_getChunk(manager);
+
+    if (chunk == Cmd_Chunk_Whole) {
+        // short line reset collected params
+        paramsLen = 0;
+        firsts++;
+        lasts++;
+    }
+    else {
+        firsts += (chunk & Cmd_Chunk_First) != 0;
+        lasts += (chunk & Cmd_Chunk_Last) != 0;
+    }
+    chunks++;
+    Mem_copy(&params[paramsLen], cursor->Ptr, cursor->Len);
+    paramsLen += cursor->Len;
+    params[paramsLen] = '\0';
+    return Cmd_Done;
+}
+static void onOverflow(CmdManager* manager) {
+    overflows++;
+}
+
+static const Cmd CMD_HEX = CMD_INIT_OPT("hex", Cmd_Type_Set, Cmd_Option_Chunked, NULL, Hex_onSet, NULL, NULL, NULL);
+
+static const Cmd_Array CMDS[] = {
+    &CMD_HEX,
+};
+
+static const Cmd_Str CRLF = CMD_STR_INIT("\r\n");
+
+int main(void) {
+    CmdManager manager;
+    IStream stream;
+    uint8_t streamBuffer[128];
+    char buffer[16];
+    Param_Cursor cursor;
+    int round;
+
+    CmdManager_init(&manager, (Cmd_Array*) CMDS, CMD_ARR_LEN(CMDS));
+    CmdManager_setEndWith(&manager, (Cmd_Str*) &CRLF);
+    CmdManager_onOverflow(&manager, onOverflow);
+    IStream_init(&stream, NULL, streamBuffer, sizeof(streamBuffer));
+
+    // EndWith of first line start at last byte of second chunk
+    Test_feed(&stream, "hex=0123456789ABCDEFGHIJKLMNO\r\n");
+    for (round = 0; round < 8 && IStream_available(&stream) > 0; round++) {
+        CmdManager_handleStatic(&manager, &stream, buffer, sizeof(buffer), &cursor);
+    }
+    Test_assert(IStream_available(&stream) == 0);
+    Test_assert(Str_compare(params, "0123456789ABCDEFGHIJKLMNO") == 0);
+    Test_assert(chunks >= 2);
+    Test_assert(firsts == 1);
+    Test_assert(lasts == 1);
+
+    // next line process as whole
+    Test_feed(&stream, "hex=1\r\n");
+    for (round = 0; round < 8 && IStream_available(&stream) > 0; round++) {
+        CmdManager_handleStatic(&manager, &stream, buffer, sizeof(buffer), &cursor);
+    }
+    Test_assert(IStream_available(&stream) == 0);
+    Test_assert(Str_compare(params, "1") == 0);
+    Test_assert(firsts == 2);
+    Test_assert(lasts == 2);
+    Test_assert(overflows == 0);
+
+    return 0;
+}
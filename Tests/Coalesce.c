@@ -0,0 +1,101 @@
+/**
+ * @file Coalesce.c
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief test superseded Set commands skip only when next Set surely run
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "Test.h"
+
+static int32_t values[8];
+static int leds;
+
+static Cmd_Handled Led_onSet(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    Param param;
+
+    if (CmdManager_nextParam(cursor, &param) == NULL || param.Value.Type != Param_ValueType_Number) {
+        return Cmd_Error;
+    }
+    values[leds++ & 7] = param.Value.Number;
+    return Cmd_Done;
+}
+static Cmd_Handled Pwm_onSet(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    return Cmd_Done;
+}
+static Cmd_Handled Bad_onSet(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    return Cmd_Error;
+}
+static Cmd_Handled Multi_onExe(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    // first call start, next statement is payload
+    return manager->InUseFn == NULL ? Cmd_Continue : Cmd_Done;
+}
+
+static const Cmd CMD_LED = CMD_INIT_OPT("led", Cmd_Type_Set, Cmd_Option_Coalesce, NULL, Led_onSet, NULL, NULL, NULL);
+static const Cmd CMD_PWM = CMD_INIT_OPT("pwm", Cmd_Type_Set, Cmd_Option_None, NULL, Pwm_onSet, NULL, NULL, NULL);
+static const Cmd CMD_BAD = CMD_INIT_OPT("bad", Cmd_Type_Set, Cmd_Option_None, NULL, Bad_onSet, NULL, NULL, NULL);
+static const Cmd CMD_MULTI = CMD_INIT_OPT("multi", Cmd_Type_Execute, Cmd_Option_Multiline, Multi_onExe, NULL, NULL, NULL, NULL);
+
+static const Cmd_Array CMDS[] = {
+    &CMD_BAD,
+    &CMD_LED,
+    &CMD_MULTI,
+    &CMD_PWM,
+};
+
+static void process(CmdManager* manager, const char* str) {
+    char buffer[48];
+    Param_Cursor cursor;
+    Str_LenType len = Str_len(str);
+
+    leds = 0;
+    Mem_copy(buffer, str, len + 1);
+    CmdManager_processLine(manager, buffer, len, &cursor);
+}
+
+int main(void) {
+    CmdManager manager;
+    Cmd_Stats* stats;
+    Cmd_Limit limits[CMD_ARR_LEN(CMDS)];
+
+    CmdManager_init(&manager, (Cmd_Array*) CMDS, CMD_ARR_LEN(CMDS));
+    CmdManager_setStatementSeparator(&manager, ';');
+    stats = CmdManager_getStats(&manager);
+
+    process(&manager, "led=1;led=2");
+    Test_assert(leds == 1 && values[0] == 2);
+    Test_assert(stats->Coalesced == 1);
+
+    // command between them can't take next statements
+    process(&manager, "led=1;pwm=5;led=2");
+    Test_assert(leds == 1 && values[0] == 2);
+    Test_assert(stats->Coalesced == 2);
+
+    // multi line command take next Set as payload
+    process(&manager, "led=1;multi;led=2");
+    Test_assert(leds == 1 && values[0] == 1);
+
+    // errors between them stop the line
+    CmdManager_setStopOnError(&manager, 1);
+    process(&manager, "led=1;bad=0;led=2");
+    Test_assert(leds == 1 && values[0] == 1);
+    process(&manager, "led=1;nope;led=2");
+    Test_assert(leds == 1 && values[0] == 1);
+    process(&manager, "led=1;led=2");
+    Test_assert(leds == 1 && values[0] == 2);
+    CmdManager_setStopOnError(&manager, 0);
+
+    // next Set may shed by own limit
+    CmdManager_resetStats(&manager);
+    Mem_set(limits, 0, sizeof(limits));
+    CmdManager_setLimits(&manager, limits, CMD_ARR_LEN(limits));
+    Test_assert(CmdManager_setCmdLimit(&manager, "led", 1, 0));
+    process(&manager, "led=1;led=2");
+    Test_assert(leds == 1 && values[0] == 1);
+    Test_assert(stats->Coalesced == 0);
+    Test_assert(stats->Shed == 1);
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file Encoder.c
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief test encoded commands, reject of strings and unknown values that can not decode
+ * and types that cmd not support
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "Test.h"
+#include "CmdEncoder.h"
+#include <string.h>
+
+static const Cmd CMD_NAME = CMD_INIT("name", Cmd_Type_Any, NULL, NULL, NULL, NULL, NULL);
+static const Cmd CMD_RESET = CMD_INIT("reset", Cmd_Type_Execute, NULL, NULL, NULL, NULL, NULL);
+
+static const Cmd_Array CMDS[] = {
+    &CMD_NAME,
+    &CMD_RESET,
+};
+
+int main(void) {
+    CmdManager manager;
+    CmdEncoder encoder;
+    Param_Value value;
+    char buffer[64];
+    char unknown[8];
+    Str_LenType len;
+
+    CmdManager_init(&manager, (Cmd_Array*) CMDS, CMD_ARR_LEN(CMDS));
+    CmdEncoder_init(&encoder, &manager, buffer, sizeof(buffer));
+
+    Test_assert(CmdEncoder_begin(&encoder, &CMD_NAME, Cmd_Type_Set) == CmdEncoder_Ok);
+    Test_assert(CmdEncoder_string(&encoder, "node 1") == CmdEncoder_Ok);
+    Test_assert(CmdEncoder_number(&encoder, -42) == CmdEncoder_Ok);
+    Test_assert(CmdEncoder_end(&encoder) == CmdEncoder_Ok);
+    Test_assert(Str_compare(buffer, "name=\"node 1\",-42\n") == 0);
+    len = CmdEncoder_len(&encoder);
+
+    // strings that break parse of line discard whole command
+    Test_assert(CmdEncoder_begin(&encoder, &CMD_NAME, Cmd_Type_Set) == CmdEncoder_Ok);
+    Test_assert(CmdEncoder_string(&encoder, "a\"b") == CmdEncoder_InvalidValue);
+    Test_assert(CmdEncoder_end(&encoder) == CmdEncoder_InvalidValue);
+    Test_assert(CmdEncoder_len(&encoder) == len);
+
+    Test_assert(CmdEncoder_begin(&encoder, &CMD_NAME, Cmd_Type_Set) == CmdEncoder_Ok);
+    Test_assert(CmdEncoder_string(&encoder, "a,b") == CmdEncoder_InvalidValue);
+    Test_assert(CmdEncoder_end(&encoder) == CmdEncoder_InvalidValue);
+
+    Test_assert(CmdEncoder_begin(&encoder, &CMD_NAME, Cmd_Type_Set) == CmdEncoder_Ok);
+    Test_assert(CmdEncoder_string(&encoder, "a\nb") == CmdEncoder_InvalidValue);
+    Test_assert(CmdEncoder_end(&encoder) == CmdEncoder_InvalidValue);
+
+    Test_assert(CmdEncoder_begin(&encoder, &CMD_NAME, Cmd_Type_Set) == CmdEncoder_Ok);
+    Test_assert(CmdEncoder_string(&encoder, "a\\b") == CmdEncoder_InvalidValue);
+    Test_assert(CmdEncoder_end(&encoder) == CmdEncoder_InvalidValue);
+
+    // unknown values have no quotes
+    Test_assert(CmdEncoder_begin(&encoder, &CMD_NAME, Cmd_Type_Set) == CmdEncoder_Ok);
+    value.Type = Param_ValueType_Unknown;
+    strcpy(unknown, "1\nled");
+    value.Unknown = unknown;
+    Test_assert(CmdEncoder_param(&encoder, &value) == CmdEncoder_InvalidValue);
+    Test_assert(CmdEncoder_end(&encoder) == CmdEncoder_InvalidValue);
+
+    // receiver reject type that cmd not support
+    Test_assert(CmdEncoder_begin(&encoder, &CMD_RESET, Cmd_Type_Set) == CmdEncoder_InvalidValue);
+    Test_assert(CmdEncoder_end(&encoder) == CmdEncoder_InvalidValue);
+
+    Test_assert(CmdEncoder_len(&encoder) == len);
+    Test_assert(Str_compareFix(buffer, "name=\"node 1\",-42\n", len) == 0);
+
+    Test_assert(CmdEncoder_begin(&encoder, &CMD_NAME, Cmd_Type_Set) == CmdEncoder_Ok);
+    strcpy(unknown, "abc");
+    Test_assert(CmdEncoder_param(&encoder, &value) == CmdEncoder_Ok);
+    Test_assert(CmdEncoder_end(&encoder) == CmdEncoder_Ok);
+    Test_assert(Str_compare(&buffer[len], "name=abc\n") == 0);
+
+    return 0;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file Image.c
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief test save and load of table image, lookup of loaded table and reject of out of bound offsets
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "Test.h"
+#include "CmdImage.h"
+#include <stdio.h>
+
+static int executes;
+
+static Cmd_Handled Test_onExe(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    executes++;
+    return Cmd_Done;
+}
+static Cmd_Handled Test_onSet(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    return Cmd_Done;
+}
+/* same hash of image content */
+static uint32_t Test_hash(const void* data, uint32_t len) {
+    const uint8_t* ptr = (const uint8_t*) data;
+    uint32_t hash = 2166136261UL;
+
+    while (len-- > 0) {
+        hash ^= *ptr++;
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
+static const Cmd CMD_LED = CMD_INIT("led", Cmd_Type_Execute, Test_onExe);
+static const Cmd CMD_PWM = CMD_INIT("pwm", Cmd_Type_Set, NULL, Test_onSet);
+static const Cmd CMD_FAN = CMD_INIT("fan", Cmd_Type_Execute, Test_onExe);
+static const Cmd CMD_RESET = CMD_INIT("reset", Cmd_Type_Execute, Test_onExe);
+
+static const Cmd_Array CMDS[] = {
+    &CMD_LED,
+    &CMD_PWM,
+    &CMD_FAN,
+    &CMD_RESET,
+};
+
+static const char* const SYMBOL_NAMES[] = {
+    "Test_onExe",
+    "Test_onSet",
+};
+static const Cmd_CallbackFn SYMBOL_FNS[] = {
+    Test_onExe,
+    Test_onSet,
+};
+static const CmdImage_Symbols SYMBOLS = {
+    SYMBOL_NAMES,
+    SYMBOL_FNS,
+    2,
+};
+
+int main(void) {
+    static uint32_t image[256];
+    static uint32_t corrupted[256];
+    CmdImage_Header* header = (CmdImage_Header*) corrupted;
+    void* memory[64];
+    Cmd_Table table;
+    Cmd_Table loaded;
+    Cmd_Str name;
+    Cmd_LenType index;
+    uint16_t* nameOffsets;
+
+    Test_assert(CmdTable_build(&table, (Cmd_Array*) CMDS, CMD_ARR_LEN(CMDS), memory, sizeof(memory)));
+    Test_assert(CmdImage_size(&table) <= sizeof(image));
+    // table without lookup can not save
+    table.Lookup = NULL;
+    Test_assert(CmdImage_save(&table, &SYMBOLS, 7, image, sizeof(image)) == CmdImage_NoLookup);
+    Test_assert(CmdTable_build(&table, (Cmd_Array*) CMDS, CMD_ARR_LEN(CMDS), memory, sizeof(memory)));
+    Test_assert(CmdImage_save(&table, &SYMBOLS, 7, image, sizeof(image)) == CmdImage_Ok);
+    Test_assert(CmdImage_load(&loaded, &SYMBOLS, 7, image, sizeof(image)) == CmdImage_Ok);
+    // loaded table keep lookup and find same indexes
+    Test_assert(loaded.Lookup != NULL);
+    for (index = 0; index < CMD_ARR_LEN(CMDS); index++) {
+        name.Text = CMDS[index]->CmdName.Text;
+        name.Len = CMDS[index]->CmdName.Len;
+        Test_assert(CmdTable_find(&loaded, &name) == (Mem_LenType) index);
+    }
+    Test_assert(CmdTable_getCallback(&loaded, 0, Cmd_TypeIndex_Execute) == Test_onExe);
+    Test_assert(CmdTable_getCallback(&loaded, 1, Cmd_TypeIndex_Set) == Test_onSet);
+
+    // name out of packed names with valid hash
+    Mem_copy(corrupted, image, sizeof(image));
+    nameOffsets = (uint16_t*) (header + 1);
+    nameOffsets[3] = header->NamesLen;
+    header->ContentHash = Test_hash(header + 1, header->Size - sizeof(CmdImage_Header));
+    Test_assert(CmdImage_load(&loaded, &SYMBOLS, 7, corrupted, sizeof(corrupted)) == CmdImage_Corrupted);
+    // lookup out of commands
+    Mem_copy(corrupted, image, sizeof(image));
+    nameOffsets[2 * header->Len] = header->Len;
+    header->ContentHash = Test_hash(header + 1, header->Size - sizeof(CmdImage_Header));
+    Test_assert(CmdImage_load(&loaded, &SYMBOLS, 7, corrupted, sizeof(corrupted)) == CmdImage_Corrupted);
+
+#if CMD_IMAGE_MMAP
+    {
+        const char* path = "TestImage.bin";
+        FILE* file = fopen(path, "wb");
+        Test_assert(file != NULL);
+        // bytes after image must not effect load and unmap
+        Test_assert(fwrite(image, 1, sizeof(image), file) == sizeof(image));
+        Test_assert(fwrite(corrupted, 1, sizeof(corrupted), file) == sizeof(corrupted));
+        fclose(file);
+        Test_assert(CmdImage_map(&loaded, &SYMBOLS, 7, path) == CmdImage_Ok);
+        name.Text = "reset";
+        name.Len = 5;
+        Test_assert(CmdTable_find(&loaded, &name) == 3);
+        CmdImage_unmap(&loaded);
+        Test_assert(CmdImage_map(&loaded, &SYMBOLS, 7, "TestImage.none") == CmdImage_OpenError);
+        remove(path);
+    }
+#endif // CMD_IMAGE_MMAP
+
+    return 0;
+}
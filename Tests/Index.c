@@ -0,0 +1,75 @@
+/**
+ * @file Index.c
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief test complete and suggest follow table and published versions of registry
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "Test.h"
+
+static Cmd_Handled Test_onExe(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    return Cmd_Done;
+}
+
+static Cmd CMD_LED = CMD_INIT("led", Cmd_Type_Execute, Test_onExe);
+static Cmd CMD_LEDS = CMD_INIT("leds", Cmd_Type_Execute, Test_onExe);
+static Cmd CMD_PWM = CMD_INIT("pwm", Cmd_Type_Execute, Test_onExe);
+static Cmd CMD_LEVEL = CMD_INIT("level", Cmd_Type_Execute, Test_onExe);
+static Cmd CMD_LAMP = CMD_INIT("lamp", Cmd_Type_Execute, Test_onExe);
+
+static Cmd_Array CMDS[] = {
+    &CMD_LED,
+    &CMD_PWM,
+};
+static Cmd_Array CMDS_V2[] = {
+    &CMD_LED,
+    &CMD_LEDS,
+    &CMD_LEVEL,
+};
+static Cmd_Array CMDS_TABLE[] = {
+    &CMD_LAMP,
+    &CMD_PWM,
+};
+
+int main(void) {
+    CmdManager manager;
+    Cmd_Registry registry;
+    Cmd_Table table;
+    void* memory[64];
+    Cmd_IndexNode nodes[32];
+    Cmd_LenType order[8];
+    Cmd* result[4];
+    Cmd_Suggestion suggestions[4];
+
+    CmdManager_init(&manager, CMDS, CMD_ARR_LEN(CMDS));
+    Test_assert(CmdManager_setIndex(&manager, nodes, CMD_ARR_LEN(nodes), order));
+    Test_assert(CmdManager_complete(&manager, "le", 2, result, 4) == 1);
+    Test_assert(result[0] == &CMD_LED);
+
+    // table replace list
+    Test_assert(CmdTable_build(&table, CMDS_TABLE, CMD_ARR_LEN(CMDS_TABLE), memory, sizeof(memory)));
+    CmdManager_setTable(&manager, &table);
+    Test_assert(CmdManager_complete(&manager, "l", 1, result, 4) == 1);
+    Test_assert(result[0] == &CMD_LAMP);
+    Test_assert(CmdManager_suggest(&manager, "pvm", 3, 1, suggestions, 4) == 1);
+    Test_assert(suggestions[0].Cmd == &CMD_PWM);
+    CmdManager_setTable(&manager, NULL);
+
+    // index follow published version
+    CmdRegistry_init(&registry, CMDS, CMD_ARR_LEN(CMDS));
+    CmdManager_setRegistry(&manager, &registry);
+    Test_assert(CmdManager_complete(&manager, "le", 2, result, 4) == 1);
+    CmdRegistry_publish(&registry, CMDS_V2, CMD_ARR_LEN(CMDS_V2));
+    Test_assert(CmdManager_complete(&manager, "le", 2, result, 4) == 3);
+    Test_assert(result[0] == &CMD_LED);
+    Test_assert(result[1] == &CMD_LEDS);
+    Test_assert(result[2] == &CMD_LEVEL);
+    Test_assert(CmdManager_complete(&manager, "p", 1, result, 4) == 0);
+    Test_assert(CmdManager_suggest(&manager, "lvel", 4, 1, suggestions, 4) == 1);
+    Test_assert(suggestions[0].Cmd == &CMD_LEVEL);
+
+    return 0;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file Ipc.c
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief test sessions of CmdIpc, drop of corrupted request ring and attaching channel with stale pid
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "Test.h"
+#include "CmdIpc.h"
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define TEST_IPC_NAME           "/cmd-ipc-test"
+
+static int sets;
+static int sessions;
+
+static Cmd_Handled Test_onSet(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    sets++;
+    CmdIpc_respond(manager, "OK", 2);
+    return Cmd_Done;
+}
+static void onSession(CmdIpc_Server* server, CmdIpc_Session* session, uint8_t index) {
+    // limits of template must not share with session
+    if (session->Manager.Limits == NULL) {
+        sessions++;
+    }
+}
+
+static Cmd CMD_LED = CMD_INIT("led", Cmd_Type_Set, NULL, Test_onSet);
+
+static Cmd_Array CMDS[] = {
+    &CMD_LED,
+};
+
+int main(void) {
+    static CmdIpc_Server server;
+    CmdIpc_Client client;
+    CmdIpc_Client other;
+    CmdIpc_Channel* attaching;
+    pid_t dead;
+    CmdManager manager;
+    Cmd_Limit limits[CMD_ARR_LEN(CMDS)] = {0};
+    CmdIpc_Ring* ring;
+    char response[8];
+    uint16_t len;
+    uint32_t head;
+
+    CmdManager_init(&manager, CMDS, CMD_ARR_LEN(CMDS));
+    CmdManager_setLimits(&manager, limits, CMD_ARR_LEN(limits));
+    Test_assert(CmdIpc_open(&server, TEST_IPC_NAME, &manager) == CmdIpc_Ok);
+    CmdIpc_onSession(&server, onSession);
+    Test_assert(CmdIpcClient_connect(&client, TEST_IPC_NAME) == CmdIpc_Ok);
+    ring = &client.Channel->Request;
+
+    Test_assert(CmdIpcClient_send(&client, "led=1", 5, 0) == CmdIpc_Ok);
+    Test_assert(CmdIpc_poll(&server, 0) == 1);
+    Test_assert(sets == 1);
+    Test_assert(sessions == 1);
+    Test_assert(CmdIpcClient_receive(&client, response, sizeof(response), 0) == 2);
+
+    // head beyond size of ring
+    head = ring->Head;
+    ring->Head = head + CMD_IPC_RING_SIZE + 8;
+    Test_assert(CmdIpc_poll(&server, 0) == 0);
+    Test_assert(ring->Tail == ring->Head);
+
+    // record longer than published bytes
+    head = ring->Head;
+    len = 5;
+    memcpy(&ring->Data[head & (CMD_IPC_RING_SIZE - 1)], &len, sizeof(len));
+    memcpy(&ring->Data[(head + sizeof(len)) & (CMD_IPC_RING_SIZE - 1)], "led", 3);
+    ring->Head = head + sizeof(len) + 3;
+    Test_assert(CmdIpc_poll(&server, 0) == 0);
+    Test_assert(ring->Tail == ring->Head);
+    Test_assert(sets == 1);
+
+    // ring work after drop
+    Test_assert(CmdIpcClient_send(&client, "led=2", 5, 0) == CmdIpc_Ok);
+    Test_assert(CmdIpc_poll(&server, 0) == 1);
+    Test_assert(sets == 2);
+
+    // channel in middle of attach keep pid of dead previous owner, must not close
+    dead = fork();
+    if (dead == 0) {
+        _exit(0);
+    }
+    Test_assert(dead > 0 && waitpid(dead, NULL, 0) == dead);
+    attaching = &client.Shared->Channels[1];
+    attaching->Pid = (int32_t) dead;
+    attaching->State = 3;
+    Test_assert(CmdIpcClient_connect(&other, TEST_IPC_NAME) == CmdIpc_Ok);
+    Test_assert(other.Channel == &other.Shared->Channels[2]);
+    Test_assert(attaching->State == 3);
+    CmdIpcClient_close(&other);
+    attaching->State = 0;
+
+    CmdIpcClient_close(&client);
+    CmdIpc_close(&server);
+    return 0;
+}
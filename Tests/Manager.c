@@ -0,0 +1,71 @@
+/**
+ * @file Manager.c
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief test resolve of names and types, params and not found commands
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "Test.h"
+
+static int executes;
+static int sets;
+static int gets;
+static int notFounds;
+static int32_t value;
+
+static Cmd_Handled Led_onExe(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    executes++;
+    return Cmd_Done;
+}
+static Cmd_Handled Led_onSet(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    Param param;
+    sets++;
+    if (CmdManager_nextParam(cursor, &param) == NULL || param.Value.Type != Param_ValueType_Number) {
+        return Cmd_Error;
+    }
+    value = param.Value.Number;
+    return Cmd_Done;
+}
+static Cmd_Handled Led_onGet(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    gets++;
+    return Cmd_Done;
+}
+static void onNotFound(CmdManager* manager, char* str) {
+    notFounds++;
+}
+
+static const Cmd CMD_LED = CMD_INIT("led", Cmd_Type_Any, Led_onExe, Led_onSet, Led_onGet, NULL, NULL);
+static const Cmd CMD_PWM = CMD_INIT("pwm", Cmd_Type_Set, NULL, Led_onSet, NULL, NULL, NULL);
+
+static const Cmd_Array CMDS[] = {
+    &CMD_LED,
+    &CMD_PWM,
+};
+
+int main(void) {
+    CmdManager manager;
+    IStream stream;
+    uint8_t streamBuffer[128];
+    char buffer[32];
+    Param_Cursor cursor;
+
+    CmdManager_init(&manager, (Cmd_Array*) CMDS, CMD_ARR_LEN(CMDS));
+    CmdManager_onNotFound(&manager, onNotFound);
+    IStream_init(&stream, NULL, streamBuffer, sizeof(streamBuffer));
+
+    Test_feed(&stream, "led\nLED=12\nled?\npwm=7\npwm?\nfan=1\n");
+    while (IStream_available(&stream) > 0) {
+        CmdManager_handleStatic(&manager, &stream, buffer, sizeof(buffer), &cursor);
+    }
+    Test_assert(executes == 1);
+    Test_assert(sets == 2);
+    Test_assert(gets == 1);
+    Test_assert(value == 7);
+    // pwm has no get type and fan not exists
+    Test_assert(notFounds == 2);
+
+    return 0;
+}
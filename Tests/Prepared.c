@@ -0,0 +1,114 @@
+/**
+ * @file Prepared.c
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief test bind of prepared params, limits and in use command on execute
+ * and reject of prepared command after publish of registry
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "Test.h"
+#include <stddef.h>
+#include <string.h>
+
+static int sets;
+static int logs;
+static char params[CMD_PREPARED_SIZE];
+
+static Cmd_Handled Test_onSet(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    sets++;
+    Mem_copy(params, cursor->Ptr, cursor->Len + 1);
+    return Cmd_Done;
+}
+static Cmd_Handled Test_onLog(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    logs++;
+    // first call start log, next lines end it
+    return manager->InUseFn == NULL ? Cmd_Continue : Cmd_Done;
+}
+
+static Cmd CMD_PWM = CMD_INIT("pwm", Cmd_Type_Set, NULL, Test_onSet);
+static Cmd CMD_LOG = CMD_INIT("log", Cmd_Type_Execute, Test_onLog);
+
+static Cmd_Array CMDS[] = {
+    &CMD_PWM,
+    &CMD_LOG,
+};
+
+int main(void) {
+    CmdManager manager;
+    Cmd_Registry registry;
+    Cmd_Prepared pwm;
+    Cmd_Prepared log;
+    Cmd_Limit limits[CMD_ARR_LEN(CMDS)] = {0};
+    char text[CMD_PREPARED_SIZE + 1];
+    char line[8];
+    Param_Cursor cursor;
+
+    CmdManager_init(&manager, CMDS, CMD_ARR_LEN(CMDS));
+    Test_assert(CmdManager_prepare(&manager, &pwm, "pwm=1,50", 8));
+    Test_assert(CmdManager_execute(&manager, &pwm, &cursor) == Cmd_Done);
+    Test_assert(sets == 1);
+    Test_assert(strcmp(params, "1,50") == 0);
+
+    // bind new params, from inside of prepared buffer too
+    Test_assert(CmdPrepared_bind(&pwm, "2,60", 4));
+    Test_assert(CmdPrepared_bind(&pwm, &pwm.Params[2], 2));
+    Test_assert(CmdManager_execute(&manager, &pwm, &cursor) == Cmd_Done);
+    Test_assert(strcmp(params, "60") == 0);
+    // params that end inside of prepared buffer overlap it
+    Test_assert(!CmdPrepared_bind(&pwm, (char*) &pwm + offsetof(Cmd_Prepared, Params) - 1, 2));
+    // params and line must fit with null terminator
+    memset(text, '1', sizeof(text));
+    Test_assert(!CmdPrepared_bind(&pwm, text, CMD_PREPARED_SIZE));
+    Test_assert(CmdPrepared_bind(&pwm, text, CMD_PREPARED_SIZE - 1));
+    Test_assert(pwm.Len == CMD_PREPARED_SIZE - 1);
+    Test_assert(pwm.Params[CMD_PREPARED_SIZE - 1] == '\0');
+    Test_assert(!CmdManager_prepare(&manager, &log, text, CMD_PREPARED_SIZE));
+    Test_assert(CmdPrepared_bind(&pwm, "3", 1));
+
+    // prepared command not run while multi line command in use
+    Test_assert(CmdManager_prepare(&manager, &log, "log", 3));
+    Test_assert(CmdManager_execute(&manager, &log, &cursor) == Cmd_Continue);
+    sets = 0;
+    Test_assert(CmdManager_execute(&manager, &pwm, &cursor) == Cmd_Error);
+    Test_assert(sets == 0);
+    strcpy(line, "end");
+    CmdManager_processLine(&manager, line, 3, &cursor);
+    Test_assert(logs == 2);
+    Test_assert(manager.InUseFn == NULL);
+    Test_assert(CmdManager_execute(&manager, &pwm, &cursor) == Cmd_Done);
+    Test_assert(sets == 1);
+
+    // limits of lines and commands apply to prepared commands
+    CmdManager_setLimit(&manager, 1, 0);
+    Test_assert(CmdManager_execute(&manager, &pwm, &cursor) == Cmd_Done);
+    Test_assert(CmdManager_execute(&manager, &pwm, &cursor) == Cmd_Error);
+    Test_assert(sets == 2);
+    Test_assert(manager.Limit.Shed == 1);
+    CmdManager_setLimit(&manager, 0, 0);
+    CmdManager_setLimits(&manager, limits, CMD_ARR_LEN(limits));
+    Test_assert(CmdManager_setCmdLimit(&manager, "pwm", 1, 0));
+    Test_assert(CmdManager_prepare(&manager, &pwm, "pwm=4", 5));
+    Test_assert(CmdManager_execute(&manager, &pwm, &cursor) == Cmd_Done);
+    Test_assert(CmdManager_execute(&manager, &pwm, &cursor) == Cmd_Error);
+    Test_assert(sets == 3);
+    Test_assert(limits[0].Shed == 1);
+    CmdManager_setLimits(&manager, NULL, 0);
+
+    // prepared command belong to version of registry
+    CmdRegistry_init(&registry, CMDS, CMD_ARR_LEN(CMDS));
+    CmdManager_setRegistry(&manager, &registry);
+    Test_assert(CmdManager_prepare(&manager, &pwm, "pwm=5", 5));
+    Test_assert(CmdManager_execute(&manager, &pwm, &cursor) == Cmd_Done);
+    Test_assert(sets == 4);
+    CmdRegistry_publish(&registry, CMDS, CMD_ARR_LEN(CMDS));
+    Test_assert(CmdManager_execute(&manager, &pwm, &cursor) == Cmd_Error);
+    Test_assert(sets == 4);
+    Test_assert(CmdManager_prepare(&manager, &pwm, "pwm=6", 5));
+    Test_assert(CmdManager_execute(&manager, &pwm, &cursor) == Cmd_Done);
+    Test_assert(sets == 5);
+
+    return 0;
+}
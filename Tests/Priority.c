@@ -0,0 +1,95 @@
+/**
+ * @file Priority.c
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief test priority lines of stream run before pending lines, except after lines
+ * that may take next lines or not found
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "Test.h"
+
+static char events[64];
+static int eventsLen;
+
+static void record(char event) {
+    events[eventsLen++] = event;
+    events[eventsLen] = '\0';
+}
+static Cmd_Handled Led_onSet(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    Param param;
+
+    if (CmdManager_nextParam(cursor, &param) == NULL || param.Value.Type != Param_ValueType_Number) {
+        return Cmd_Error;
+    }
+    record((char) ('0' + param.Value.Number));
+    return Cmd_Done;
+}
+static Cmd_Handled Stop_onExe(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    record('S');
+    return Cmd_Done;
+}
+static Cmd_Handled Multi_onExe(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    if (manager->InUseFn == NULL) {
+        record('M');
+        return Cmd_Continue;
+    }
+    // next line is payload
+    record('P');
+    return Cmd_Done;
+}
+static void onNotFound(CmdManager* manager, char* str) {
+    record('?');
+}
+
+static const Cmd CMD_LED = CMD_INIT_OPT("led", Cmd_Type_Set, Cmd_Option_None, NULL, Led_onSet, NULL, NULL, NULL);
+static const Cmd CMD_STOP = CMD_INIT_OPT("stop", Cmd_Type_Execute, Cmd_Option_Priority, Stop_onExe, NULL, NULL, NULL, NULL);
+static const Cmd CMD_MULTI = CMD_INIT_OPT("multi", Cmd_Type_Execute, Cmd_Option_Multiline, Multi_onExe, NULL, NULL, NULL, NULL);
+
+static const Cmd_Array CMDS[] = {
+    &CMD_LED,
+    &CMD_MULTI,
+    &CMD_STOP,
+};
+
+static void handle(CmdManager* manager, IStream* stream, const char* str) {
+    char buffer[24];
+    Param_Cursor cursor;
+    int round;
+
+    eventsLen = 0;
+    events[0] = '\0';
+    Test_feed(stream, str);
+    for (round = 0; round < 32 && IStream_available(stream) > 0; round++) {
+        CmdManager_handleBatch(manager, stream, buffer, sizeof(buffer), &cursor);
+    }
+}
+
+int main(void) {
+    CmdManager manager;
+    IStream stream;
+    uint8_t streamBuffer[256];
+
+    CmdManager_init(&manager, (Cmd_Array*) CMDS, CMD_ARR_LEN(CMDS));
+    CmdManager_onNotFound(&manager, onNotFound);
+    IStream_init(&stream, NULL, streamBuffer, sizeof(streamBuffer));
+
+    // stop is behind more lines than fit in buffer
+    handle(&manager, &stream, "led=1\nled=2\nled=3\nled=4\nled=5\nled=6\nled=7\nled=8\nstop\nled=9\n");
+    Test_assert(IStream_available(&stream) == 0);
+    Test_assert(Str_compare(events, "S123456789") == 0);
+
+    // multi line command take next line, stop wait for it
+    handle(&manager, &stream, "led=1\nmulti\nled=2\nstop\n");
+    Test_assert(IStream_available(&stream) == 0);
+    Test_assert(Str_compare(events, "1MPS") == 0);
+
+    // not found line keep order
+    handle(&manager, &stream, "led=1\nnope\nstop\nled=2\n");
+    Test_assert(IStream_available(&stream) == 0);
+    Test_assert(Str_compare(events, "1?S2") == 0);
+
+    return 0;
+}
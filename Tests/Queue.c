@@ -0,0 +1,123 @@
+/**
+ * @file Queue.c
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief test queue keep order, drop on full or long lines and multiple producers
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "Test.h"
+#include "CmdQueue.h"
+#include <stdio.h>
+#include <pthread.h>
+#include <sched.h>
+
+#define TEST_PRODUCERS          4
+#define TEST_LINES              5000
+
+typedef struct {
+    CmdQueue*   Queue;
+    uint32_t    Id;
+    uint32_t    Pushed;
+} Test_Producer;
+
+static int32_t last[TEST_PRODUCERS];
+static uint32_t received;
+static uint32_t outOfOrder;
+
+static Cmd_Handled Test_onSet(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    Param id;
+    Param value;
+
+    if (CmdManager_nextParam(cursor, &id) == NULL || CmdManager_nextParam(cursor, &value) == NULL) {
+        return Cmd_Error;
+    }
+    // lines of each producer must come in order of push
+    if (value.Value.Number <= last[id.Value.Number]) {
+        outOfOrder++;
+    }
+    last[id.Value.Number] = value.Value.Number;
+    received++;
+    return Cmd_Done;
+}
+static void* Test_produce(void* args) {
+    Test_Producer* producer = (Test_Producer*) args;
+    char line[24];
+    int32_t value = 0;
+    int len;
+
+    while (value < TEST_LINES) {
+        len = snprintf(line, sizeof(line), "p=%u,%d", (unsigned) producer->Id, (int) value);
+        if (CmdQueue_push(producer->Queue, line, (Str_LenType) len) == CmdQueue_Ok) {
+            producer->Pushed++;
+            value++;
+        }
+        else {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static const Cmd CMD_P = CMD_INIT("p", Cmd_Type_Set, NULL, Test_onSet);
+
+static const Cmd_Array CMDS[] = {
+    &CMD_P,
+};
+
+int main(void) {
+    CmdManager manager;
+    CmdQueue queue;
+    CmdQueue_Slot slots[8];
+    char lines[8 * 24];
+    Param_Cursor cursor;
+    Test_Producer producers[TEST_PRODUCERS];
+    pthread_t threads[TEST_PRODUCERS];
+    uint32_t index;
+
+    CmdManager_init(&manager, (Cmd_Array*) CMDS, CMD_ARR_LEN(CMDS));
+    CmdQueue_init(&queue, slots, lines, 8, 24);
+    for (index = 0; index < TEST_PRODUCERS; index++) {
+        last[index] = -1;
+    }
+
+    // full and long lines drop
+    for (index = 0; index < 8; index++) {
+        Test_assert(CmdQueue_push(&queue, "p=0,1", 5) == CmdQueue_Ok);
+    }
+    Test_assert(CmdQueue_push(&queue, "p=0,2", 5) == CmdQueue_Full);
+    Test_assert(CmdQueue_push(&queue, "p=0,123456789012345678901", 25) == CmdQueue_TooLong);
+    Test_assert(CmdQueue_dropped(&queue) == 2);
+    Test_assert(CmdQueue_len(&queue) == 8);
+    Test_assert(CmdQueue_drain(&queue, &manager, 3, &cursor) == 3);
+    Test_assert(CmdQueue_len(&queue) == 5);
+    CmdQueue_reset(&queue);
+    Test_assert(CmdQueue_len(&queue) == 0);
+    last[0] = -1;
+    received = 0;
+    outOfOrder = 0;
+
+    // producers on other threads, consumer on main thread
+    for (index = 0; index < TEST_PRODUCERS; index++) {
+        producers[index].Queue = &queue;
+        producers[index].Id = index;
+        producers[index].Pushed = 0;
+        Test_assert(pthread_create(&threads[index], NULL, Test_produce, &producers[index]) == 0);
+    }
+    while (received < TEST_PRODUCERS * TEST_LINES) {
+        if (CmdQueue_drain(&queue, &manager, 0, &cursor) == 0) {
+            sched_yield();
+        }
+    }
+    for (index = 0; index < TEST_PRODUCERS; index++) {
+        pthread_join(threads[index], NULL);
+        Test_assert(producers[index].Pushed == TEST_LINES);
+        Test_assert(last[index] == TEST_LINES - 1);
+    }
+    Test_assert(outOfOrder == 0);
+    Test_assert(CmdQueue_len(&queue) == 0);
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file RateLimit.c
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief test limits of lines on line and batch paths, limits of commands, refill
+ * and limits after publish of longer list
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "Test.h"
+#include <string.h>
+
+static int sets;
+static int overloads;
+
+static Cmd_Handled Test_onSet(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    sets++;
+    return Cmd_Done;
+}
+static void onOverload(CmdManager* manager, Cmd* cmd, char* str) {
+    overloads++;
+}
+
+static Cmd CMD_LED = CMD_INIT("led", Cmd_Type_Set, NULL, Test_onSet);
+static Cmd CMD_PWM = CMD_INIT("pwm", Cmd_Type_Set, NULL, Test_onSet);
+static Cmd CMD_FAN = CMD_INIT("fan", Cmd_Type_Set, NULL, Test_onSet);
+
+static Cmd_Array CMDS[] = {
+    &CMD_LED,
+    &CMD_PWM,
+};
+static Cmd_Array LONGER[] = {
+    &CMD_LED,
+    &CMD_PWM,
+    &CMD_FAN,
+};
+
+static void handle(CmdManager* manager, IStream* stream, const char* str) {
+    char buffer[32];
+    Param_Cursor cursor;
+    int round;
+
+    Test_feed(stream, str);
+    for (round = 0; round < 16 && IStream_available(stream) > 0; round++) {
+        CmdManager_handleBatch(manager, stream, buffer, sizeof(buffer), &cursor);
+    }
+}
+
+int main(void) {
+    CmdManager manager;
+    Cmd_Registry registry;
+    // guard after limits catch access out of array
+    struct {
+        Cmd_Limit   Limits[CMD_ARR_LEN(CMDS)];
+        Cmd_Limit   Guard;
+    } limits = {0};
+    IStream stream;
+    uint8_t streamBuffer[128];
+    char line[16];
+    Param_Cursor cursor;
+
+    CmdManager_init(&manager, CMDS, CMD_ARR_LEN(CMDS));
+    CmdManager_onOverload(&manager, onOverload);
+    IStream_init(&stream, NULL, streamBuffer, sizeof(streamBuffer));
+
+    // each line of batch take a token
+    CmdManager_setLimit(&manager, 2, 10);
+    handle(&manager, &stream, "led=1\nled=2\nled=3\npwm=4\n");
+    Test_assert(IStream_available(&stream) == 0);
+    Test_assert(sets == 2);
+    Test_assert(overloads == 2);
+    Test_assert(manager.Limit.Shed == 2);
+    // refill after period
+    CmdManager_tick(&manager, 10);
+    strcpy(line, "led=5");
+    CmdManager_processLine(&manager, line, 5, &cursor);
+    strcpy(line, "led=6");
+    CmdManager_processLine(&manager, line, 5, &cursor);
+    Test_assert(sets == 3);
+    Test_assert(overloads == 3);
+
+    // limit of a command
+    CmdManager_setLimit(&manager, 0, 0);
+    CmdManager_setLimits(&manager, limits.Limits, CMD_ARR_LEN(limits.Limits));
+    Test_assert(CmdManager_setCmdLimit(&manager, "pwm", 1, 0));
+    sets = 0;
+    handle(&manager, &stream, "pwm=1\npwm=2\nled=3\n");
+    Test_assert(sets == 2);
+    Test_assert(limits.Limits[1].Shed == 1);
+
+    // published list is longer than limits and pwm move after end of limits,
+    // led take index of exhausted limit of pwm
+    CmdLimit_init(&limits.Guard, 1, 0);
+    limits.Guard.Tokens = 0;
+    CmdRegistry_init(&registry, CMDS, CMD_ARR_LEN(CMDS));
+    CmdManager_setRegistry(&manager, &registry);
+    CmdRegistry_publish(&registry, LONGER, CMD_ARR_LEN(LONGER));
+    sets = 0;
+    handle(&manager, &stream, "fan=1\nled=2\npwm=3\n");
+    Test_assert(sets == 3);
+    Test_assert(limits.Limits[1].Shed == 1);
+    Test_assert(limits.Guard.Shed == 0);
+
+    return 0;
+}
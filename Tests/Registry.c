@@ -0,0 +1,97 @@
+/**
+ * @file Registry.c
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief test publish wait for pinned reader, nested pins and lookups of unpinned manager
+ * use current version and own commands restore after leave
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "Test.h"
+#include <pthread.h>
+#include <unistd.h>
+
+static Cmd_Handled Test_onSet(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    return Cmd_Done;
+}
+
+static Cmd CMD_LED = CMD_INIT("led", Cmd_Type_Set, NULL, Test_onSet);
+static Cmd CMD_PWM = CMD_INIT("pwm", Cmd_Type_Set, NULL, Test_onSet);
+static Cmd CMD_FAN = CMD_INIT("fan", Cmd_Type_Set, NULL, Test_onSet);
+
+static Cmd_Array OWN[] = {
+    &CMD_LED,
+};
+static Cmd_Array FIRST[] = {
+    &CMD_LED,
+    &CMD_PWM,
+};
+static Cmd_Array SECOND[] = {
+    &CMD_FAN,
+    &CMD_LED,
+};
+static Cmd_Array THIRD[] = {
+    &CMD_FAN,
+    &CMD_PWM,
+};
+
+static Cmd_Registry registry;
+static uint32_t published;
+
+static void* Test_publish(void* args) {
+    CmdRegistry_publish(&registry, SECOND, CMD_ARR_LEN(SECOND));
+    __atomic_store_n(&published, 1, __ATOMIC_RELEASE);
+    // previous version pinned by reader, wait until leave
+    CmdRegistry_publish(&registry, THIRD, CMD_ARR_LEN(THIRD));
+    __atomic_store_n(&published, 2, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+int main(void) {
+    CmdManager manager;
+    Cmd_Limit limits[2] = {0};
+    pthread_t thread;
+    uint8_t slot;
+
+    CmdManager_init(&manager, OWN, CMD_ARR_LEN(OWN));
+    CmdManager_setLimits(&manager, limits, CMD_ARR_LEN(limits));
+    CmdRegistry_init(&registry, FIRST, CMD_ARR_LEN(FIRST));
+    CmdManager_setRegistry(&manager, &registry);
+    Test_assert(CmdManager_setCmdLimit(&manager, "pwm", 1, 0));
+    // own commands restore after leave
+    Test_assert(manager.List.Cmds == OWN);
+
+    slot = CmdRegistry_enter(&registry, &manager);
+    Test_assert(manager.List.Cmds == FIRST);
+    // nested enter keep pinned version
+    Test_assert(CmdRegistry_enter(&registry, &manager) == slot);
+    Test_assert(pthread_create(&thread, NULL, Test_publish, NULL) == 0);
+    while (__atomic_load_n(&published, __ATOMIC_ACQUIRE) == 0) {
+        usleep(100);
+    }
+    usleep(20000);
+    Test_assert(__atomic_load_n(&published, __ATOMIC_ACQUIRE) == 1);
+    Test_assert(!CmdRegistry_isQuiescent(&registry));
+    // lookup of pinned manager use pinned version
+    Test_assert(CmdManager_setCmdLimit(&manager, "pwm", 1, 0));
+    Test_assert(!CmdManager_setCmdLimit(&manager, "fan", 1, 0));
+    CmdRegistry_leave(&registry, &manager);
+    usleep(20000);
+    Test_assert(__atomic_load_n(&published, __ATOMIC_ACQUIRE) == 1);
+    Test_assert(manager.List.Cmds == FIRST);
+    CmdRegistry_leave(&registry, &manager);
+    Test_assert(manager.List.Cmds == OWN);
+    pthread_join(thread, NULL);
+    Test_assert(published == 2);
+    Test_assert(CmdRegistry_version(&registry) == 2);
+
+    // unpinned lookup use current version
+    Test_assert(CmdManager_setCmdLimit(&manager, "fan", 1, 0));
+    Test_assert(limits[0].Key == &CMD_FAN);
+    Test_assert(!CmdManager_setCmdLimit(&manager, "led", 1, 0));
+    Test_assert(manager.Pins == 0);
+
+    return 0;
+}
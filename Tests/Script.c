@@ -0,0 +1,90 @@
+/**
+ * @file Script.c
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief test parallel run of script, limits and in use command force sequential run and cache invalidate after run
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "Test.h"
+#include "CmdScript.h"
+#include <string.h>
+
+static uint32_t sets;
+static uint32_t gets;
+
+static Cmd_Handled Test_onSet(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    __atomic_fetch_add(&sets, 1, __ATOMIC_RELAXED);
+    return Cmd_Done;
+}
+static Cmd_Handled Test_onGet(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    __atomic_fetch_add(&gets, 1, __ATOMIC_RELAXED);
+    CmdManager_respond(manager, "1", 1);
+    return Cmd_Done;
+}
+
+static const Cmd CMD_LED = CMD_INIT("led", Cmd_Type_Set | Cmd_Type_Get, NULL, Test_onSet, Test_onGet, NULL, NULL);
+
+static const Cmd_Array CMDS[] = {
+    &CMD_LED,
+};
+
+static size_t Test_script(char* data, uint32_t lines) {
+    size_t len = 0;
+    uint32_t index;
+
+    for (index = 0; index < lines; index++) {
+        memcpy(&data[len], (index & 1) ? "led?\n" : "led=1\n", (index & 1) ? 5 : 6);
+        len += (index & 1) ? 5 : 6;
+    }
+    return len;
+}
+
+int main(void) {
+    static char data[64 * 1024];
+    CmdManager manager;
+    CmdScript_Stats stats;
+    Cmd_CacheEntry cache[CMD_ARR_LEN(CMDS)] = {0};
+    char response[8];
+    size_t len;
+    Cmd_Table table;
+    void* memory[16];
+
+    CmdManager_init(&manager, (Cmd_Array*) CMDS, CMD_ARR_LEN(CMDS));
+    CmdManager_setCache(&manager, cache, CMD_ARR_LEN(cache));
+    Test_assert(CmdManager_setCmdCache(&manager, "led", response, sizeof(response), 1000));
+
+    // parallel run don't fill cache from threads
+    len = Test_script(data, 4000);
+    Test_assert(!CmdScript_isSequential(&manager));
+    Test_assert(CmdScript_runBuffer(&manager, data, len, 4, &stats) == CmdScript_Ok);
+    Test_assert(stats.Threads > 1);
+    Test_assert(stats.Lines == 4000);
+    Test_assert(sets == 2000);
+    Test_assert(gets == 2000);
+    Test_assert(!cache[0].Valid);
+
+    // line limit apply to whole script, budget not multiply by threads
+    CmdManager_setLimit(&manager, 100, 0);
+    Test_assert(CmdScript_isSequential(&manager));
+    sets = 0;
+    len = Test_script(data, 4000);
+    Test_assert(CmdScript_runBuffer(&manager, data, len, 4, &stats) == CmdScript_Ok);
+    Test_assert(stats.Threads == 1);
+    // 100 lines admitted, half of them set
+    Test_assert(sets == 50);
+    Test_assert(manager.Limit.Shed == 3900);
+
+    // multiline command in use force sequential run even with table
+    Test_assert(CmdTable_build(&table, (Cmd_Array*) CMDS, CMD_ARR_LEN(CMDS), memory, sizeof(memory)));
+    CmdManager_init(&manager, (Cmd_Array*) CMDS, CMD_ARR_LEN(CMDS));
+    CmdManager_setTable(&manager, &table);
+    Test_assert(!CmdScript_isSequential(&manager));
+    manager.InUseCmd = (Cmd*) &CMD_LED;
+    manager.InUseFn = Test_onSet;
+    Test_assert(CmdScript_isSequential(&manager));
+
+    return 0;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file Statement.c
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief test multiple statements per line, stop on error, lines with backspaces
+ * and quotes without escape
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "Test.h"
+
+static int32_t led;
+static int32_t pwm;
+static int sets;
+static char payload[32];
+static Str_LenType payloadLen;
+
+static Cmd_Handled Value_onSet(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    Param param;
+
+    sets++;
+    if (CmdManager_nextParam(cursor, &param) == NULL || param.Value.Type != Param_ValueType_Number) {
+        return Cmd_Error;
+    }
+    if (cmd->CmdName.Text[0] == 'l') {
+        led = param.Value.Number;
+    }
+    else {
+        pwm = param.Value.Number;
+    }
+    return Cmd_Done;
+}
+static Cmd_Handled Cfg_onExe(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    if (manager->InUseFn == NULL) {
+        // first call, rest of line is payload
+        return Cmd_Continue;
+    }
+    payloadLen = cursor->Len;
+    Mem_copy(payload, cursor->Ptr, payloadLen);
+    payload[payloadLen] = '\0';
+    return Cmd_Done;
+}
+
+static const Cmd CMD_LED = CMD_INIT("led", Cmd_Type_Set, NULL, Value_onSet, NULL, NULL, NULL);
+static const Cmd CMD_PWM = CMD_INIT("pwm", Cmd_Type_Set, NULL, Value_onSet, NULL, NULL, NULL);
+static const Cmd CMD_CFG = CMD_INIT("cfg", Cmd_Type_Execute, Cfg_onExe, NULL, NULL, NULL, NULL);
+
+static const Cmd_Array CMDS[] = {
+    &CMD_CFG,
+    &CMD_LED,
+    &CMD_PWM,
+};
+
+static void process(CmdManager* manager, const char* str) {
+    char buffer[32];
+    Param_Cursor cursor;
+    Str_LenType len = Str_len(str);
+
+    Mem_copy(buffer, str, len + 1);
+    CmdManager_processLine(manager, buffer, len, &cursor);
+}
+
+int main(void) {
+    CmdManager manager;
+
+    CmdManager_init(&manager, (Cmd_Array*) CMDS, CMD_ARR_LEN(CMDS));
+    CmdManager_setStatementSeparator(&manager, ';');
+
+    process(&manager, "led=1;pwm=2");
+    Test_assert(led == 1 && pwm == 2);
+
+    // backspaces removed before split
+    process(&manager, "led=34\b5;pwm=66\b\b7");
+    Test_assert(led == 35 && pwm == 7);
+
+    // error stop rest of line
+    CmdManager_setStopOnError(&manager, 1);
+    sets = 0;
+    process(&manager, "led=x;pwm=9");
+    Test_assert(sets == 1 && pwm == 7);
+
+    // rest of line pass to multi line command without padding of removed backspaces
+    process(&manager, "cfg;ab\b\bcd;ef");
+    Test_assert(Str_compare(payload, "cd;ef") == 0);
+    Test_assert(payloadLen == 5);
+
+    // quotes have no escape, same as parser of params
+    CmdManager_setStopOnError(&manager, 0);
+    process(&manager, "led=\"a\\\";pwm=4");
+    Test_assert(pwm == 4);
+
+    return 0;
+}
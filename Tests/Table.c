@@ -0,0 +1,100 @@
+/**
+ * @file Table.c
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief test build of Cmd_Table, binary search of names and dispatch through table
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "Test.h"
+
+static int sets;
+static int executes;
+static int notFounds;
+
+static Cmd_Handled Test_onExe(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    executes++;
+    return Cmd_Done;
+}
+static Cmd_Handled Test_onSet(CmdManager* manager, Cmd* cmd, Param_Cursor* cursor, Cmd_Type type) {
+    sets++;
+    return Cmd_Done;
+}
+static void onNotFound(CmdManager* manager, char* str) {
+    notFounds++;
+}
+
+static const Cmd CMD_LED = CMD_INIT("led", Cmd_Type_Any, Test_onExe, Test_onSet, NULL, NULL, NULL);
+static const Cmd CMD_PWM = CMD_INIT("pwm", Cmd_Type_Set, NULL, Test_onSet, NULL, NULL, NULL);
+static const Cmd CMD_FAN = CMD_INIT("fan", Cmd_Type_Execute, Test_onExe, NULL, NULL, NULL, NULL);
+static const Cmd CMD_RESET = CMD_INIT("reset", Cmd_Type_Execute, Test_onExe, NULL, NULL, NULL, NULL);
+static const Cmd CMD_VOLT = CMD_INIT("volt", Cmd_Type_Set, NULL, Test_onSet, NULL, NULL, NULL);
+static const Cmd CMD_TEMP = CMD_INIT("temp", Cmd_Type_Set, NULL, Test_onSet, NULL, NULL, NULL);
+static const Cmd CMD_MODE = CMD_INIT("mode", Cmd_Type_Set, NULL, Test_onSet, NULL, NULL, NULL);
+static const Cmd CMD_BAUD = CMD_INIT("baud", Cmd_Type_Set, NULL, Test_onSet, NULL, NULL, NULL);
+static const Cmd CMD_A = CMD_INIT("a", Cmd_Type_Execute, Test_onExe, NULL, NULL, NULL, NULL);
+static const Cmd CMD_B = CMD_INIT("b", Cmd_Type_Execute, Test_onExe, NULL, NULL, NULL, NULL);
+
+static const Cmd_Array CMDS[] = {
+    &CMD_LED,
+    &CMD_PWM,
+    &CMD_FAN,
+    &CMD_RESET,
+    &CMD_VOLT,
+    &CMD_TEMP,
+    &CMD_MODE,
+    &CMD_BAUD,
+    &CMD_A,
+    &CMD_B,
+};
+
+int main(void) {
+    CmdManager manager;
+    Cmd_Table table;
+    Cmd_Str name;
+    IStream stream;
+    uint8_t streamBuffer[128];
+    char buffer[32];
+    Param_Cursor cursor;
+    void* memory[128];
+    Cmd_LenType index;
+
+    Test_assert(CmdTable_size((Cmd_Array*) CMDS, CMD_ARR_LEN(CMDS)) <= sizeof(memory));
+    Test_assert(CmdTable_build(&table, (Cmd_Array*) CMDS, CMD_ARR_LEN(CMDS), memory, sizeof(memory)));
+    Test_assert(table.Lookup != NULL);
+    // every command found at own index of list
+    for (index = 0; index < CMD_ARR_LEN(CMDS); index++) {
+        name.Text = CMDS[index]->CmdName.Text;
+        name.Len = CMDS[index]->CmdName.Len;
+        Test_assert(CmdTable_find(&table, &name) == (Mem_LenType) index);
+    }
+    name.Text = "leds";
+    name.Len = 4;
+    Test_assert(CmdTable_find(&table, &name) == -1);
+    name.Text = "c";
+    name.Len = 1;
+    Test_assert(CmdTable_find(&table, &name) == -1);
+    // linear search when table has no lookup
+    table.Lookup = NULL;
+    name.Text = "baud";
+    name.Len = 4;
+    Test_assert(CmdTable_find(&table, &name) == 7);
+    Test_assert(CmdTable_build(&table, (Cmd_Array*) CMDS, CMD_ARR_LEN(CMDS), memory, sizeof(memory)));
+
+    CmdManager_init(&manager, (Cmd_Array*) CMDS, CMD_ARR_LEN(CMDS));
+    CmdManager_setTable(&manager, &table);
+    CmdManager_onNotFound(&manager, onNotFound);
+    IStream_init(&stream, NULL, streamBuffer, sizeof(streamBuffer));
+
+    Test_feed(&stream, "led\nvolt=5\nb\nbaud=9600\nfan\nfoo\n");
+    while (IStream_available(&stream) > 0) {
+        CmdManager_handleStatic(&manager, &stream, buffer, sizeof(buffer), &cursor);
+    }
+    Test_assert(executes == 3);
+    Test_assert(sets == 2);
+    Test_assert(notFounds == 1);
+
+    return 0;
+}
@@ -0,0 +1,41 @@
+/**
+ * @file Test.h
+ * @author Ali Mirghasemi (ali.mirghasemi1376.com)
+ * @brief common helpers of tests, each test is a program that return 0 on success
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _TEST_H_
+#define _TEST_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "InputStream.h"
+#include "Str.h"
+#include "CmdManager.h"
+
+/**
+ * @brief check condition, print location and return failure from main when it's false
+ */
+#define Test_assert(COND)           do { \
+                                        if (!(COND)) { \
+                                            printf("%s:%d: %s\n", __FILE__, __LINE__, #COND); \
+                                            return 1; \
+                                        } \
+                                    } while (0)
+/**
+ * @brief feed a string into input stream
+ */
+#define Test_feed(STREAM, STR)      do { \
+                                        const char* __p = (STR); \
+                                        while (*__p != '\0') { \
+                                            IStream_receiveByte((STREAM), (uint8_t) *__p++); \
+                                        } \
+                                    } while (0)
+
+#endif /* _TEST_H_ */